@@ -40,170 +40,777 @@ Refer to the akima.py module for documentation and tests.\n\
 \n\
 :Author: `Christoph Gohlke <https://www.cgohlke.com/>`_\n\
 :License: BSD 3-Clause\n\
-:Version: 2025.1.1\n\
+:Version: 2026.x.x\n\
 "
 
-#define _VERSION_ "2025.1.1"
+#define _VERSION_ "2026.x.x"
 
 #define WIN32_LEAN_AND_MEAN
 #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
 
 #include "Python.h"
 #include "numpy/arrayobject.h"
+#include "numpy/ufuncobject.h"
 
+#include "akima.h"
+#include "akima_probes.h"
+
+#define AKIMA_CAPI_MODULE
+#include "akima_capi.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
+
+#ifndef _WIN32
+#include <time.h>
+#endif
+
+
+static const akima_capi_t akima_capi_table = {
+    AKIMA_CAPI_VERSION,
+    akima_interpolate,
+    akima_coefficients,
+    akima_evaluate,
+    akima_spline_create,
+    akima_spline_evaluate,
+    akima_spline_destroy,
+    akima_interpolate_f,
+    akima_coefficients_f,
+    akima_evaluate_f
+};
+
+/*****************************************************************************/
+/* Call statistics */
 
 /*
-A new method of interpolation and smooth curve fitting based on local
-procedures. Hiroshi Akima, J. ACM, October 1970, 17(4), 589-602.
+Counters of interpolate calls, updated atomically from worker threads if
+enabled. Times are in nanoseconds. Coefficient and evaluation times are
+summed over threads.
 */
+enum {
+    STATS_CALLS,
+    STATS_LANES,
+    STATS_POINTS,               /* input points of all lanes */
+    STATS_OUTPOINTS,            /* output points of all lanes */
+    STATS_CONVERSIONS,          /* input arrays copied by converters */
+    STATS_BYTES_COPIED,         /* bytes of copied input arrays */
+    STATS_CONVERT_NS,           /* parsing and converting arguments */
+    STATS_COEFFICIENTS_NS,
+    STATS_EVALUATE_NS,
+    STATS_TOTAL_NS,
+    STATS_FIELDS                /* number of counters */
+};
 
-int interpolate(
-    Py_ssize_t si,            /* size of input arrays */
-    char *xi, Py_ssize_t dxi, /* x coordinates and stride */
-    char *yi, Py_ssize_t dyi, /* y coordinates and stride */
-    Py_ssize_t so,            /* size of output arrays */
-    char *xo, Py_ssize_t dxo, /* x coordinates of output and stride */
-    char *yo, Py_ssize_t dyo, /* y output coordinates and stride */
-    double *p  /* buffer for polynomial coefficients of size 4*si+4 */
-    )
-{
-    Py_ssize_t i, s;
-    double x0, x1, x2, x3;       /* extrapolated x values */
-    double y0, y1, y2, y3;       /* extrapolated y values */
-    double t0, t1, t2, t3;       /* temporary values */
-    double d0, d1;
-    double g0, g1;               /* gradients at extrapolated values */
-    double *p0, *p1, *p2, *p3;   /* buffer pointers. p3 holds slopes */
-    char *pxi, *pyi, *pxo, *pyo; /* data pointers */
-
-    p0 = p;
-    p1 = p + si + 1;
-    p2 = p + si*2 + 2;
-    p3 = p + si*3 + 3;
-
-    /* slopes of input data */
-    pxi = xi;
-    pyi = yi;
-    t0 = *((double *)pxi);
-    t1 = *((double *)pyi);
-    i = si-1;
-    while (i--) {
-        pxi += dxi;
-        pyi += dyi;
-        t0 = *((double *)pxi) - t0;
-        if (t0 < 1e-12)
-            return -1;
-        *p3++ = (*((double *)pyi) - t1) / t0;
-        t0 = *((double *)pxi);
-        t1 = *((double *)pyi);
-    }
-    p3 = p + si*3 + 3;
-
-    /* extrapolate 2 points on left side */
-    t0 = *((double *)(xi));
-    t1 = *((double *)(xi + dxi));
-    t2 = *((double *)(yi));
-    /* t3 = *((double *)(yi + dyi)); */
-
-    x1 = t0 + t1 - *((double *)(xi+dxi+dxi));
-    x0 = x1 + t0 - t1;
-    y1 = (t0 - x1) * (p3[1] - 2.0*p3[0]) + t2;
-    g1 = (t2 - y1) / (t0 - x1);
-    y0 = (x1 - x0) * (p3[0] - 2.0*g1) + y1;
-    g0 = (y1 - y0) / (x1 - x0);
-
-    /* extrapolate 2 points on right side */
-    s = (Py_ssize_t)xi + dxi*(si-1);
-    t0 = *((double *)(s - dxi));
-    t1 = *((double *)(s));
-    x2 = t1 + t0 - *((double *)(s - dxi - dxi));
-    x3 = x2 + t1 - t0;
-
-    s = (Py_ssize_t)yi + dyi*(si-1);
-    /* t2 = *((double *)(s - dyi)); */
-    t3 = *((double *)(s));
-    y2 = (2.0*p3[si-2] - p3[si-3]) * (x2 - t1) + t3;
-    p3[si-1] = (y2 - t3) / (x2 - t1);
-    y3 = (2.0*p3[si-1] - p3[si-2]) * (x3 - x2) + y2;
-    p3[si] = (y3 - y2) / (x3 - x2);
-
-    /* slopes */
-    t1 = g0;
-    t2 = g1;
-    t3 = *p3;
-    i = si;
-    while (i--) {
-        t0 = t1;
-        t1 = t2;
-        t2 = t3;
-        t3 = *(p3 + 1);
-        d0 = t3 - t2;
-        if (d0 < 0.0)
-            d0 *= -1.0;
-        d1 = t1 - t0;
-        if (d1 < 0.0)
-            d1 *= -1.0;
-        if ((d0 + d1) < 1e-9) {
-            *p3++ = 0.5 * (t1 + t2);
-        } else {
-            *p3++ = (d0*t1 + d1*t2) / (d0 + d1);
-        }
-    }
-    /* polynomial coefficients */
-    pxi = xi;
-    pyi = yi;
-    t0 = *((double *)pxi);
-    t1 = *((double *)pyi);
-    p3 = p + si*3 + 3;
-    g1 = *p3++;
-    i = si;
-    while (i--) {
-        pxi += dxi;
-        pyi += dyi;
-        d0 = (*((double *)pxi) - t0);
-        d1 = (*((double *)pyi) - t1);
-        t2 = d1 / d0;
-        g0 = g1;
-        g1 = *p3++;
-        *p0++ = t1;
-        *p1++ = (3.0*t2 - 2.0*g0 - g1) / d0;
-        *p2++ = (g0 + g1 - 2.0*t2) / (d0*d0);
-        t0 = *((double *)pxi);
-        t1 = *((double *)pyi);
-    }
-    /* interpolate data */
-    p0 = p;
-    p1 = p + si + 1;
-    p2 = p + si*2 + 2;
-    p3 = p + si*3 + 3;
-    pxi = xi;
-    pyi = yi;
-    pxo = xo;
-    pyo = yo;
-    si -= 2;
-    i = -1;
-    s = so;
-    while (s--) {
-        t0 = *((double *)pxo);
-        while ((t0 > *((double *)pxi)) && (i < si)) {
-            pxi += dxi;
-            i++;
-        }
-        if (i < 0) {
-            i = 0;
-            pxi = xi + dxi;
-        }
-        t1 = t0 - *((double *)(pxi - dxi));
-        *((double *)pyo) = p0[i] + p3[i]*t1 + p1[i]*t1*t1 + p2[i]*t1*t1*t1;
-        pyo += dyo;
-        pxo += dxo;
+typedef struct {
+    long long enabled;
+    long long counters[STATS_FIELDS];
+} stats_t;
+
+static const char *const stats_names[STATS_FIELDS] = {
+    [STATS_CALLS] = "calls",
+    [STATS_LANES] = "lanes",
+    [STATS_POINTS] = "points",
+    [STATS_OUTPOINTS] = "outpoints",
+    [STATS_CONVERSIONS] = "conversions",
+    [STATS_BYTES_COPIED] = "bytes_copied",
+    [STATS_CONVERT_NS] = "convert_ns",
+    [STATS_COEFFICIENTS_NS] = "coefficients_ns",
+    [STATS_EVALUATE_NS] = "evaluate_ns",
+    [STATS_TOTAL_NS] = "total_ns"};
+
+#if defined(_MSC_VER)
+#define STATS_ADD(ptr, value) \
+    InterlockedExchangeAdd64((volatile LONG64 *)(ptr), (LONG64)(value))
+#define STATS_EXCHANGE(ptr, value) \
+    InterlockedExchange64((volatile LONG64 *)(ptr), (LONG64)(value))
+#define STATS_LOAD(ptr) InterlockedOr64((volatile LONG64 *)(ptr), 0)
+#else
+#define STATS_ADD(ptr, value) \
+    __atomic_fetch_add((ptr), (value), __ATOMIC_RELAXED)
+#define STATS_EXCHANGE(ptr, value) \
+    __atomic_exchange_n((ptr), (value), __ATOMIC_RELAXED)
+#define STATS_LOAD(ptr) __atomic_load_n((ptr), __ATOMIC_RELAXED)
+#endif
+
+/* Return monotonic time in nanoseconds */
+static long long
+monotonic_ns(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER frequency = {0};
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return (long long)((double)counter.QuadPart * 1e9 /
+                       (double)frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + (long long)ts.tv_nsec;
+#endif
+}
+
+/*****************************************************************************/
+/* Interpolate lanes of N-D arrays, optionally in threads */
+
+/*
+Lanes are the 1D sub-arrays of x, y, x_new, and out along the
+interpolation axis. They are numbered in C order of the remaining,
+broadcast dimensions, such that consecutive lanes of contiguous arrays
+are adjacent in memory. Broadcast dimensions have zero strides.
+*/
+typedef struct {
+    Py_ssize_t size;                /* size of input arrays */
+    Py_ssize_t outsize;             /* size of output arrays */
+    char *xi, *yi, *xo, *yo;        /* data pointers */
+    Py_ssize_t dxi, dyi, dxo, dyo;  /* strides along axis */
+    int ndim;                       /* number of dimensions except axis */
+    npy_intp shape[NPY_MAXDIMS];    /* shape except axis */
+    npy_intp xistrides[NPY_MAXDIMS];
+    npy_intp yistrides[NPY_MAXDIMS];
+    npy_intp xostrides[NPY_MAXDIMS];
+    npy_intp yostrides[NPY_MAXDIMS];
+    npy_intp count;                 /* number of lanes */
+    stats_t *stats;                 /* statistics to update or NULL */
+} lanes_t;
+
+/* Byte offsets of lane in x, y, x_new, and out arrays */
+typedef struct {
+    npy_intp xi, yi, xo, yo;
+} lane_offsets_t;
+
+static void
+lane_offsets(
+    const lanes_t *lanes,
+    npy_intp lane,
+    lane_offsets_t *offsets)
+{
+    npy_intp j;
+    int i;
+
+    offsets->xi = 0;
+    offsets->yi = 0;
+    offsets->xo = 0;
+    offsets->yo = 0;
+    for (i = lanes->ndim - 1; i >= 0; i--) {
+        j = lane % lanes->shape[i];
+        lane /= lanes->shape[i];
+        offsets->xi += j * lanes->xistrides[i];
+        offsets->yi += j * lanes->yistrides[i];
+        offsets->xo += j * lanes->xostrides[i];
+        offsets->yo += j * lanes->yostrides[i];
+    }
+}
+
+/* Interpolate lanes [start, stop). Does not require the GIL */
+static int
+interpolate_lanes(
+    const void *arg,
+    npy_intp start,
+    npy_intp stop,
+    double *buffer)
+{
+    const lanes_t *lanes = (const lanes_t *)arg;
+    lane_offsets_t offsets;
+    npy_intp lane;
+    long long t0, t1, t2, coefficients_ns = 0, evaluate_ns = 0;
+    int error = 0;
+
+    if (lanes->stats != NULL) {
+        /* time phases separately */
+        for (lane = start; lane < stop; lane++) {
+            AKIMA_PROBE3(lane__start, lane, lanes->size, lanes->outsize);
+            lane_offsets(lanes, lane, &offsets);
+            t0 = monotonic_ns();
+            error = akima_coefficients(
+                lanes->size,
+                lanes->xi + offsets.xi, lanes->dxi,
+                lanes->yi + offsets.yi, lanes->dyi,
+                buffer);
+            if (error != 0) {
+                break;
+            }
+            t1 = monotonic_ns();
+            akima_evaluate(
+                lanes->size,
+                lanes->xi + offsets.xi, lanes->dxi,
+                buffer,
+                lanes->outsize,
+                lanes->xo + offsets.xo, lanes->dxo,
+                lanes->yo + offsets.yo, lanes->dyo);
+            t2 = monotonic_ns();
+            coefficients_ns += t1 - t0;
+            evaluate_ns += t2 - t1;
+        }
+        STATS_ADD(&lanes->stats->counters[STATS_COEFFICIENTS_NS],
+                  coefficients_ns);
+        STATS_ADD(&lanes->stats->counters[STATS_EVALUATE_NS], evaluate_ns);
+        return error;
+    }
+
+    for (lane = start; lane < stop; lane++) {
+        AKIMA_PROBE3(lane__start, lane, lanes->size, lanes->outsize);
+        lane_offsets(lanes, lane, &offsets);
+        error = akima_interpolate(
+            lanes->size,
+            lanes->xi + offsets.xi, lanes->dxi,
+            lanes->yi + offsets.yi, lanes->dyi,
+            lanes->outsize,
+            lanes->xo + offsets.xo, lanes->dxo,
+            lanes->yo + offsets.yo, lanes->dyo,
+            buffer);
+        if (error != 0) {
+            return error;
+        }
+    }
+    return 0;
+}
+
+/* Return address of input data of lane */
+static const char *
+lane_address(const void *arg, npy_intp lane)
+{
+    const lanes_t *lanes = (const lanes_t *)arg;
+    lane_offsets_t offsets;
+
+    lane_offsets(lanes, lane, &offsets);
+    return lanes->yi + offsets.yi;
+}
+
+/*
+Batch of independent problems with concatenated 1D x, y, x_new, and out
+arrays. The elements of problem i are at [offsets[i], offsets[i+1]) in x
+and y, and at [offsets_new[i], offsets_new[i+1]) in x_new and out.
+*/
+typedef struct {
+    char *xi, *yi, *xo, *yo;        /* data pointers */
+    Py_ssize_t dxi, dyi, dxo, dyo;  /* strides */
+    const npy_intp *offsets;
+    const npy_intp *offsets_new;
+} batch_t;
+
+/* Interpolate problems [start, stop) of batch. Does not require the GIL */
+static int
+interpolate_batch(
+    const void *arg,
+    npy_intp start,
+    npy_intp stop,
+    double *buffer)
+{
+    const batch_t *batch = (const batch_t *)arg;
+    npy_intp i, j, k;
+    int error;
+
+    for (k = start; k < stop; k++) {
+        i = batch->offsets[k];
+        j = batch->offsets_new[k];
+        if (batch->offsets_new[k + 1] == j) {
+            continue;
+        }
+        error = akima_interpolate(
+            batch->offsets[k + 1] - i,
+            batch->xi + i * batch->dxi, batch->dxi,
+            batch->yi + i * batch->dyi, batch->dyi,
+            batch->offsets_new[k + 1] - j,
+            batch->xo + j * batch->dxo, batch->dxo,
+            batch->yo + j * batch->dyo, batch->dyo,
+            buffer);
+        if (error != 0) {
+            return error;
+        }
     }
     return 0;
 }
 
+/* Return address of input data of problem */
+static const char *
+batch_address(const void *arg, npy_intp item)
+{
+    const batch_t *batch = (const batch_t *)arg;
+    return batch->yi + batch->offsets[item] * batch->dyi;
+}
+
+/*
+Independent work items, e.g. lanes, that can be partitioned among threads.
+*/
+typedef struct {
+    /* interpolate items [start, stop) using buffer of size 4*size+4 */
+    int (*run)(const void *arg, npy_intp start, npy_intp stop, double *buf);
+    /* return address of input data of item */
+    const char *(*address)(const void *arg, npy_intp item);
+    const void *arg;
+    npy_intp count;         /* number of items */
+    Py_ssize_t size;        /* largest size of input arrays of items */
+} work_t;
+
+#ifdef __linux__
+
+#define NUMA_MAXNODES 64
+
+/*
+Set CPUs of NUMA node from sysfs. Return number of CPUs or -1 if the node
+does not exist. Does not require libnuma.
+*/
+static int
+numa_node_cpus(int node, cpu_set_t *cpus)
+{
+    char path[64];
+    FILE *fh;
+    int a, b, c, count = 0;
+
+    PyOS_snprintf(path, sizeof(path),
+                  "/sys/devices/system/node/node%i/cpulist", node);
+    fh = fopen(path, "r");
+    if (fh == NULL) {
+        return -1;
+    }
+    CPU_ZERO(cpus);
+    /* list of CPU ranges, e.g. "0-31,64-95" */
+    while (fscanf(fh, "%d", &a) == 1) {
+        b = a;
+        c = fgetc(fh);
+        if (c == '-') {
+            if (fscanf(fh, "%d", &b) != 1) {
+                break;
+            }
+            c = fgetc(fh);
+        }
+        for (; (a <= b) && (a < CPU_SETSIZE); a++) {
+            CPU_SET(a, cpus);
+            count++;
+        }
+        if (c != ',') {
+            break;
+        }
+    }
+    fclose(fh);
+    return count;
+}
+
+/*
+Return NUMA node of memory page at address or -1 if unknown.
+*/
+static int
+numa_node_of(const void *address)
+{
+    int node = -1;
+
+    /* MPOL_F_NODE | MPOL_F_ADDR */
+    if (syscall(SYS_get_mempolicy, &node, NULL, 0, address, 3) != 0) {
+        return -1;
+    }
+    return node;
+}
+
+/*
+Set CPUs of NUMA nodes usable by this process. Return number of nodes.
+*/
+static int
+numa_topology(int *nodes, cpu_set_t *cpus, int maxnodes)
+{
+    cpu_set_t allowed;
+    int node, count = 0;
+
+    if (sched_getaffinity(0, sizeof(cpu_set_t), &allowed) != 0) {
+        return 0;
+    }
+    for (node = 0; (node < NUMA_MAXNODES) && (count < maxnodes); node++) {
+        if (numa_node_cpus(node, &cpus[count]) < 1) {
+            continue;
+        }
+        CPU_AND(&cpus[count], &cpus[count], &allowed);
+        if (CPU_COUNT(&cpus[count]) > 0) {
+            nodes[count++] = node;
+        }
+    }
+    return count;
+}
+
+#endif /* __linux__ */
+
+typedef struct {
+    const work_t *work;
+    npy_intp start;         /* first item */
+    npy_intp stop;          /* last item + 1 */
+    int error;
+#ifdef __linux__
+    cpu_set_t *cpus;        /* CPUs of NUMA node to run on or NULL */
+#endif
+#ifdef _WIN32
+    HANDLE thread;
+#else
+    pthread_t thread;
+#endif
+    int started;
+} task_t;
+
+static void
+task_run(task_t *task)
+{
+    double *buffer;
+
+#ifdef __linux__
+    if (task->cpus != NULL) {
+        /* pin worker thread to NUMA node. Pages of the newly allocated
+           output array are first touched, hence placed, on that node */
+        sched_setaffinity(0, sizeof(cpu_set_t), task->cpus);
+    }
+#endif
+    buffer = (double *)PyMem_RawMalloc(
+        AKIMA_BUFFER_SIZE(task->work->size) * sizeof(double));
+    if (buffer == NULL) {
+        task->error = -2;
+        return;
+    }
+    task->error = task->work->run(
+        task->work->arg, task->start, task->stop, buffer);
+    PyMem_RawFree(buffer);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI
+task_thread(LPVOID arg)
+{
+    task_run((task_t *)arg);
+    return 0;
+}
+#else
+static void *
+task_thread(void *arg)
+{
+    task_run((task_t *)arg);
+    return NULL;
+}
+#endif
+
+/* Return number of CPUs available to the process */
+static int
+cpu_count(void)
+{
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#elif defined(__linux__)
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(cpu_set_t), &allowed) == 0) {
+        return CPU_COUNT(&allowed);
+    }
+    return 1;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count < 1) ? 1 : (int)count;
+#endif
+}
+
+/*
+Run all work items in up to maxworkers threads. Return 0 on success,
+-1 if x is not monotonically increasing, or -2 if out of memory.
+
+Items are partitioned into contiguous blocks, one per thread. On Linux
+systems with several NUMA nodes, each thread is pinned to the node holding
+the input data of its block, or, if unknown, to nodes in block order.
+
+If not NULL, buffer of size 4*size+4 is used when running in the
+calling thread.
+
+Does not require the GIL.
+*/
+static int
+run_threaded(const work_t *work, int maxworkers, double *buffer)
+{
+    task_t *tasks;
+    npy_intp block;
+    int i, error = 0, nworkers = maxworkers;
+#ifdef __linux__
+    int j, node, nnodes;
+    int nodes[NUMA_MAXNODES];
+    cpu_set_t *cpus = NULL;
+#endif
+
+    if (nworkers < 1) {
+        nworkers = cpu_count();
+    }
+    if (nworkers > work->count) {
+        nworkers = (int)work->count;
+    }
+    if ((nworkers < 2) && (buffer != NULL)) {
+        return work->run(work->arg, 0, work->count, buffer);
+    }
+    if (nworkers < 2) {
+        task_t task;
+        task.work = work;
+        task.start = 0;
+        task.stop = work->count;
+#ifdef __linux__
+        task.cpus = NULL;
+#endif
+        task_run(&task);
+        return task.error;
+    }
+
+    tasks = (task_t *)PyMem_RawCalloc(nworkers, sizeof(task_t));
+    if (tasks == NULL) {
+        return -2;
+    }
+
+#ifdef __linux__
+    cpus = (cpu_set_t *)PyMem_RawMalloc(NUMA_MAXNODES * sizeof(cpu_set_t));
+    nnodes = (cpus == NULL) ? 0 : numa_topology(nodes, cpus, NUMA_MAXNODES);
+#endif
+
+    block = (work->count + nworkers - 1) / nworkers;
+    for (i = 0; i < nworkers; i++) {
+        task_t *task = &tasks[i];
+        task->work = work;
+        task->start = i * block;
+        task->stop = (i + 1) * block;
+        if (task->stop > work->count) {
+            task->stop = work->count;
+        }
+#ifdef __linux__
+        task->cpus = NULL;
+        if ((nnodes > 1) && (task->start < task->stop)) {
+            node = numa_node_of(work->address(work->arg, task->start));
+            for (j = 0; j < nnodes; j++) {
+                if (nodes[j] == node) {
+                    break;
+                }
+            }
+            if (j == nnodes) {
+                j = (int)(((npy_intp)i * nnodes) / nworkers);
+            }
+            task->cpus = &cpus[j];
+        }
+#endif
+#ifdef _WIN32
+        task->thread = CreateThread(NULL, 0, task_thread, task, 0, NULL);
+        task->started = (task->thread != NULL);
+#else
+        task->started = (
+            pthread_create(&task->thread, NULL, task_thread, task) == 0);
+#endif
+        if (!task->started) {
+            /* run in calling thread without pinning */
+#ifdef __linux__
+            task->cpus = NULL;
+#endif
+            task_run(task);
+        }
+    }
+
+    for (i = 0; i < nworkers; i++) {
+        task_t *task = &tasks[i];
+        if (task->started) {
+#ifdef _WIN32
+            WaitForSingleObject(task->thread, INFINITE);
+            CloseHandle(task->thread);
+#else
+            pthread_join(task->thread, NULL);
+#endif
+        }
+        if ((task->error != 0) && (error == 0)) {
+            error = task->error;
+        }
+    }
+
+#ifdef __linux__
+    PyMem_RawFree(cpus);
+#endif
+    PyMem_RawFree(tasks);
+    return error;
+}
+
 /*****************************************************************************/
 /* Python functions */
 
+/*
+Handling of input arrays that must be converted to float64.
+COPY_DEFAULT is set if the mode is the module default from AKIMA_COPY,
+COPY_STRING if the copy argument is a string.
+*/
+enum {
+    COPY_ALLOW, COPY_WARN, COPY_NEVER, COPY_DEFAULT = 0x10, COPY_STRING = 0x20
+};
+
+struct module_state {
+    PyObject *workspace_type;
+    stats_t stats;
+    int copy_mode;  /* default copy mode, from AKIMA_COPY */
+};
+
+#define GETSTATE(m) ((struct module_state*)PyModule_GetState(m))
+
+#if PY_VERSION_HEX < 0x030D0000
+#define Py_BEGIN_CRITICAL_SECTION(op) {
+#define Py_END_CRITICAL_SECTION() }
+#endif
+
+/*
+Workspace type.
+
+Owns the buffer for polynomial coefficients, which grows to the largest
+size of input arrays it is used with. Passing a Workspace to interpolate
+avoids allocating the buffer on every call.
+*/
+typedef struct {
+    PyObject_HEAD
+    double *buffer;
+    Py_ssize_t size;  /* largest size of input arrays buffer is valid for */
+} WorkspaceObject;
+
+char workspace_doc[] =
+    "Workspace(size=0)\n\n"
+    "Reusable buffer for interpolate.\n\n"
+    "Preallocate buffer for input arrays of up to size elements. "
+    "The buffer grows as needed.";
+
+static PyObject *
+workspace_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    WorkspaceObject *self;
+    Py_ssize_t size = 0;
+
+    static char *kwlist[] = {"size", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|n", kwlist, &size))
+        return NULL;
+
+    if (size < 0) {
+        PyErr_Format(PyExc_ValueError, "size must not be negative");
+        return NULL;
+    }
+
+    self = (WorkspaceObject *)type->tp_alloc(type, 0);
+    if (self == NULL) {
+        return NULL;
+    }
+    self->buffer = NULL;
+    self->size = 0;
+    if (size > 0) {
+        self->buffer = (double *)PyMem_Malloc(
+            AKIMA_BUFFER_SIZE(size) * sizeof(double));
+        if (self->buffer == NULL) {
+            Py_DECREF(self);
+            return PyErr_NoMemory();
+        }
+        self->size = size;
+    }
+    return (PyObject *)self;
+}
+
+static void
+workspace_dealloc(WorkspaceObject *self)
+{
+    PyTypeObject *type = Py_TYPE(self);
+    PyMem_Free(self->buffer);
+    type->tp_free((PyObject *)self);
+    Py_DECREF(type);
+}
+
+static PyObject *
+workspace_get_size(WorkspaceObject *self, void *Py_UNUSED(closure))
+{
+    Py_ssize_t size;
+    Py_BEGIN_CRITICAL_SECTION(self);
+    size = self->size;
+    Py_END_CRITICAL_SECTION();
+    return PyLong_FromSsize_t(size);
+}
+
+static PyGetSetDef workspace_getset[] = {
+    {"size", (getter)workspace_get_size, NULL,
+        "Largest size of input arrays the buffer is allocated for.", NULL},
+    {NULL} /* Sentinel */
+};
+
+static PyType_Slot workspace_slots[] = {
+    {Py_tp_new, workspace_new},
+    {Py_tp_dealloc, workspace_dealloc},
+    {Py_tp_getset, workspace_getset},
+    {Py_tp_doc, workspace_doc},
+    {0, NULL} /* Sentinel */
+};
+
+static PyType_Spec workspace_spec = {
+    "akima._akima.Workspace",
+    sizeof(WorkspaceObject),
+    0,
+    Py_TPFLAGS_DEFAULT,
+    workspace_slots
+};
+
+/*
+Take buffer for input arrays of up to *size elements from workspace and set
+*size to the size the buffer is valid for. The workspace is left empty
+while the buffer is in use, such that concurrent calls sharing the
+workspace allocate their own buffer. Requires the GIL.
+*/
+static double *
+workspace_take(WorkspaceObject *self, Py_ssize_t *size)
+{
+    double *buffer;
+    Py_ssize_t bufsize;
+
+    Py_BEGIN_CRITICAL_SECTION(self);
+    buffer = self->buffer;
+    bufsize = self->size;
+    self->buffer = NULL;
+    self->size = 0;
+    Py_END_CRITICAL_SECTION();
+
+    if (bufsize < *size) {
+        PyMem_Free(buffer);
+        buffer = (double *)PyMem_Malloc(
+            AKIMA_BUFFER_SIZE(*size) * sizeof(double));
+    } else {
+        *size = bufsize;
+    }
+    return buffer;
+}
+
+/*
+Return buffer taken for input arrays of size to workspace. Requires the GIL.
+*/
+static void
+workspace_give(WorkspaceObject *self, double *buffer, Py_ssize_t size)
+{
+    Py_BEGIN_CRITICAL_SECTION(self);
+    if (size > self->size) {
+        PyMem_Free(self->buffer);
+        self->buffer = buffer;
+        self->size = size;
+        buffer = NULL;
+    }
+    Py_END_CRITICAL_SECTION();
+    PyMem_Free(buffer);
+}
+
+/*
+Return whether object is an aligned, native float64 array, which the
+kernel can use without conversion.
+*/
+static int
+is_native_double_array(PyObject *object)
+{
+    PyArrayObject *obj = (PyArrayObject *)object;
+    return (PyArray_Check(object)
+            && (PyArray_TYPE(obj) == NPY_DOUBLE)
+            && PyArray_ISALIGNED(obj)
+            && PyArray_ISNOTSWAPPED(obj));
+}
+
 /*
 Numpy array converters for use with PyArg_Parse functions.
 */
@@ -212,9 +819,8 @@ PyConverter_AnyDoubleArray(
     PyObject *object,
     PyObject **address)
 {
-    PyArrayObject *obj = (PyArrayObject *)object;
-    if (PyArray_Check(object)
-        && (PyArray_TYPE((const PyArrayObject *)object) == NPY_DOUBLE)) {
+    if (is_native_double_array(object)) {
+        /* fast path: use native float64 array as is */
         *address = object;
         Py_INCREF(object);
         return NPY_SUCCEED;
@@ -250,72 +856,295 @@ PyOutputConverter_AnyDoubleArrayOrNone(
     }
 }
 
+/*
+Parse copy argument: None for the module default, True to allow, "warn"
+to warn about, or False or "never" to raise on conversion of inputs.
+Return 0 or -1 on error.
+*/
+static int
+parse_copy_mode(PyObject *object, int default_mode, int *mode)
+{
+    int value;
+
+    if ((object == NULL) || (object == Py_None)) {
+        *mode = default_mode | COPY_DEFAULT;
+        return 0;
+    }
+    if (PyUnicode_Check(object)) {
+        if (PyUnicode_CompareWithASCIIString(object, "warn") == 0) {
+            *mode = COPY_WARN | COPY_STRING;
+            return 0;
+        }
+        if (PyUnicode_CompareWithASCIIString(object, "never") == 0) {
+            *mode = COPY_NEVER | COPY_STRING;
+            return 0;
+        }
+        PyErr_Format(PyExc_ValueError,
+            "copy must be None, True, False, 'warn', or 'never'");
+        return -1;
+    }
+    value = PyObject_IsTrue(object);
+    if (value < 0) {
+        return -1;
+    }
+    *mode = value ? COPY_ALLOW : COPY_NEVER;
+    return 0;
+}
+
+/*
+Convert input argument to aligned, native float64 array according to
+copy mode. Return NPY_SUCCEED or NPY_FAIL.
+*/
+static int
+convert_input(
+    const char *fname,
+    const char *name,
+    PyObject *object,
+    int mode,
+    PyObject **address)
+{
+    const char *forbids = (mode & COPY_DEFAULT) ? "AKIMA_COPY=never" :
+                          (mode & COPY_STRING) ? "copy='never'" : "copy=False";
+
+    mode &= ~(COPY_DEFAULT | COPY_STRING);
+    if ((mode == COPY_NEVER) && !is_native_double_array(object)) {
+        PyErr_Format(PyExc_ValueError,
+            "%s() would copy %s to aligned, native float64 array, "
+            "which %s forbids", fname, name, forbids);
+        return NPY_FAIL;
+    }
+    if (!PyConverter_AnyDoubleArray(object, address)) {
+        return NPY_FAIL;
+    }
+    if ((mode == COPY_WARN) && (*address != object)) {
+        if (PyErr_WarnFormat(PyExc_RuntimeWarning, 1,
+                "%s() copied %s to float64 array of %zd bytes", fname, name,
+                (Py_ssize_t)PyArray_NBYTES((PyArrayObject *)*address)) < 0) {
+            Py_CLEAR(*address);
+            return NPY_FAIL;
+        }
+    }
+    return NPY_SUCCEED;
+}
+
+static int
+PyConverter_IntpArray(
+    PyObject *object,
+    PyObject **address)
+{
+    *address = PyArray_FROM_OTF(object, NPY_INTP, NPY_ARRAY_IN_ARRAY);
+    if (*address == NULL) {
+        PyErr_Format(PyExc_ValueError, "can not convert to array");
+        return NPY_FAIL;
+    }
+    return NPY_SUCCEED;
+}
+
+/*
+Parse arguments of METH_FASTCALL|METH_KEYWORDS functions into values,
+borrowed references ordered as in NULL terminated kwlist. Values of
+missing optional arguments are set to NULL. Return 0 or -1 on error.
+*/
+static int
+parse_fastcall(
+    const char *fname,
+    PyObject *const *args,
+    Py_ssize_t nargs,
+    PyObject *kwnames,
+    const char *const *kwlist,
+    Py_ssize_t nrequired,
+    PyObject **values)
+{
+    Py_ssize_t i, j, nkwlist, nkwargs;
+
+    for (nkwlist = 0; kwlist[nkwlist] != NULL; nkwlist++) {
+        values[nkwlist] = NULL;
+    }
+    nkwargs = (kwnames == NULL) ? 0 : PyTuple_GET_SIZE(kwnames);
+
+    if (nargs > nkwlist) {
+        PyErr_Format(PyExc_TypeError,
+            "%s() takes at most %zd arguments (%zd given)",
+            fname, nkwlist, nargs);
+        return -1;
+    }
+    for (i = 0; i < nargs; i++) {
+        values[i] = args[i];
+    }
+    for (i = 0; i < nkwargs; i++) {
+        PyObject *name = PyTuple_GET_ITEM(kwnames, i);
+        for (j = 0; j < nkwlist; j++) {
+            if (PyUnicode_CompareWithASCIIString(name, kwlist[j]) == 0) {
+                break;
+            }
+        }
+        if (j == nkwlist) {
+            PyErr_Format(PyExc_TypeError,
+                "%s() got an unexpected keyword argument '%U'", fname, name);
+            return -1;
+        }
+        if (values[j] != NULL) {
+            PyErr_Format(PyExc_TypeError,
+                "argument for %s() given by name ('%s') and position (%zd)",
+                fname, kwlist[j], j + 1);
+            return -1;
+        }
+        values[j] = args[nargs + i];
+    }
+    for (i = 0; i < nrequired; i++) {
+        if (values[i] == NULL) {
+            PyErr_Format(PyExc_TypeError,
+                "%s() missing required argument '%s' (pos %zd)",
+                fname, kwlist[i], i + 1);
+            return -1;
+        }
+    }
+    return 0;
+}
+
 /*
 Interpolate array along axis using Akima's method.
 */
 char py_interpolate_doc[] =
-    "Return interpolated data along axis using Akima's method.";
+    "Return interpolated data along axis using Akima's method.\n\n"
+    "x and x_new are 1D or broadcast against y except along axis.\n"
+    "Lanes are interpolated in up to maxworkers threads "
+    "(default 1, 0 for number of CPUs).\n"
+    "Workspace, if provided, holds the buffer for polynomial coefficients.\n"
+    "Inputs that are not aligned, native float64 arrays are copied. "
+    "If copy is False, raise ValueError instead, "
+    "or if 'warn', issue RuntimeWarning. "
+    "The default is set by the AKIMA_COPY environment variable "
+    "('never' or 'warn').\n"
+    "Calls are counted and timed if enabled with stats().";
 
 static PyObject *
 py_interpolate(
     PyObject *obj,
-    PyObject *args,
-    PyObject *kwds)
+    PyObject *const *args,
+    Py_ssize_t nargs,
+    PyObject *kwnames)
 {
     PyArrayObject *xdata = NULL;
     PyArrayObject *data = NULL;
     PyArrayObject *xout = NULL;
     PyArrayObject *out = NULL;
     PyArrayObject *oout = NULL;
-    PyArrayIterObject *dit = NULL;
-    PyArrayIterObject *oit = NULL;
-    npy_intp dstride, ostride, xdstride, xostride, size, outsize;
+    PyObject *workspace = NULL;
+    PyObject *values[8];
+    lanes_t lanes;
+    work_t work;
+    npy_intp size, outsize;
+    Py_ssize_t bufsize = 0;
     Py_ssize_t newshape[NPY_MAXDIMS];
     int axis = NPY_MAXDIMS;
-    int i, ndim, error;
+    int maxworkers = 1;
+    int i, ndim, error, xdaxis, xoaxis, copy;
     double *buffer = NULL;
+    stats_t *stats = &GETSTATE(obj)->stats;
+    long long t0 = 0, t1 = 0;
+    NPY_BEGIN_THREADS_DEF;
+
+    static const char *const kwlist[] = {
+        "x", "y", "x_new", "axis", "out", "maxworkers", "workspace", "copy",
+        NULL};
+
+    AKIMA_PROBE0(interpolate__call);
+    if (STATS_LOAD(&stats->enabled)) {
+        t0 = monotonic_ns();
+    } else {
+        stats = NULL;
+    }
+
+    if (parse_fastcall("interpolate", args, nargs, kwnames, kwlist, 3, values)
+        || parse_copy_mode(values[7], GETSTATE(obj)->copy_mode, &copy)
+        || !convert_input("interpolate", "x", values[0], copy,
+                          (PyObject **)&xdata)
+        || !convert_input("interpolate", "y", values[1], copy,
+                          (PyObject **)&data)
+        || !convert_input("interpolate", "x_new", values[2], copy,
+                          (PyObject **)&xout)
+        || ((values[3] != NULL) && !PyArray_AxisConverter(values[3], &axis))
+        || !PyOutputConverter_AnyDoubleArrayOrNone(values[4], &oout))
+        goto _fail;
 
-    static char *kwlist[] = {"x", "y", "x_new", "axis", "out", NULL};
+    if (values[5] != NULL) {
+        long value = PyLong_AsLong(values[5]);
+        if ((value == -1) && PyErr_Occurred())
+            goto _fail;
+        maxworkers = (value > INT_MAX) ? INT_MAX : (int)value;
+    }
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O&O&O&|O&O&", kwlist,
-        PyConverter_AnyDoubleArray, &xdata,
-        PyConverter_AnyDoubleArray, &data,
-        PyConverter_AnyDoubleArray, &xout,
-        PyArray_AxisConverter, &axis,
-        PyOutputConverter_AnyDoubleArrayOrNone, &oout))
+    if (values[6] != Py_None) {
+        workspace = values[6];
+    }
+    if ((workspace != NULL) && !PyObject_TypeCheck(
+            workspace, (PyTypeObject *)GETSTATE(obj)->workspace_type)) {
+        PyErr_Format(PyExc_TypeError, "workspace must be Workspace instance");
         goto _fail;
+    }
 
     /* check axis */
     ndim = PyArray_NDIM(data);
     if ((axis == NPY_MAXDIMS) || (axis == -1)) {
         axis = ndim - 1;
-    } else if ((axis < 0) || (axis > NPY_MAXDIMS)) {
+    } else if ((axis < 0) || (axis >= ndim)) {
         PyErr_Format(PyExc_ValueError, "invalid axis");
         goto _fail;
     }
 
-    if ((PyArray_NDIM(xdata) != 1) || (PyArray_NDIM(xout) != 1)) {
+    if (((PyArray_NDIM(xdata) != 1) && (PyArray_NDIM(xdata) != ndim))
+        || ((PyArray_NDIM(xout) != 1) && (PyArray_NDIM(xout) != ndim))) {
         PyErr_Format(PyExc_ValueError,
-            "x-arrays must be one dimensional");
+            "x-arrays must be one dimensional or match data dimensions");
         goto _fail;
     }
+    /* axis of x-arrays */
+    xdaxis = (PyArray_NDIM(xdata) == 1) ? 0 : axis;
+    xoaxis = (PyArray_NDIM(xout) == 1) ? 0 : axis;
 
     size = PyArray_DIM(data, axis);
-    outsize = PyArray_DIM(xout, 0);
+    outsize = PyArray_DIM(xout, xoaxis);
 
     if (size < 3) {
         PyErr_Format(PyExc_ValueError, "size along axis is too small");
         goto _fail;
     }
 
-    if (size != PyArray_DIM(xdata, 0)) {
+    if (size != PyArray_DIM(xdata, xdaxis)) {
         PyErr_Format(PyExc_ValueError,
             "size of x-array must match data shape at axis");
         goto _fail;
     }
 
+    /* broadcast non-axis dimensions of x, y, and x_new */
     for (i = 0; i < ndim; i++) {
-        newshape[i] = (i == axis) ? outsize : PyArray_DIM(data, i);
+        npy_intp dim = PyArray_DIM(data, i);
+        if (i == axis) {
+            newshape[i] = outsize;
+            continue;
+        }
+        if ((PyArray_NDIM(xdata) > 1) && (PyArray_DIM(xdata, i) != 1)) {
+            if ((dim != 1) && (dim != PyArray_DIM(xdata, i))) {
+                dim = -1;
+            } else {
+                dim = PyArray_DIM(xdata, i);
+            }
+        }
+        if ((dim >= 0) && (PyArray_NDIM(xout) > 1)
+            && (PyArray_DIM(xout, i) != 1)) {
+            if ((dim != 1) && (dim != PyArray_DIM(xout, i))) {
+                dim = -1;
+            } else {
+                dim = PyArray_DIM(xout, i);
+            }
+        }
+        if (dim < 0) {
+            PyErr_Format(PyExc_ValueError,
+                "x-arrays can not be broadcast to data shape");
+            goto _fail;
+        }
+        newshape[i] = dim;
     }
 
     if (oout == NULL) {
@@ -340,41 +1169,282 @@ py_interpolate(
     }
 
     /* iterate over all but specified axis */
-    dit = (PyArrayIterObject *)PyArray_IterAllButAxis((PyObject *)data, &axis);
-    oit = (PyArrayIterObject *)PyArray_IterAllButAxis((PyObject *)out, &axis);
-    dstride = PyArray_STRIDE(data, axis);
-    ostride = PyArray_STRIDE(out, axis);
-    xdstride = PyArray_STRIDE(xdata, 0);
-    xostride = PyArray_STRIDE(xout, 0);
-
-    buffer = (double *)PyMem_Malloc((size * 4 + 4) * sizeof(double));
-    if (buffer == NULL) {
+    lanes.size = size;
+    lanes.outsize = outsize;
+    lanes.xi = PyArray_DATA(xdata);
+    lanes.dxi = PyArray_STRIDE(xdata, xdaxis);
+    lanes.yi = PyArray_DATA(data);
+    lanes.dyi = PyArray_STRIDE(data, axis);
+    lanes.xo = PyArray_DATA(xout);
+    lanes.dxo = PyArray_STRIDE(xout, xoaxis);
+    lanes.yo = PyArray_DATA(out);
+    lanes.dyo = PyArray_STRIDE(out, axis);
+    lanes.ndim = 0;
+    lanes.count = 1;
+    lanes.stats = stats;
+    for (i = 0; i < ndim; i++) {
+        if (i != axis) {
+            npy_intp dim = newshape[i];
+            int j = lanes.ndim;
+            lanes.shape[j] = dim;
+            lanes.xistrides[j] = ((PyArray_NDIM(xdata) == 1)
+                || (PyArray_DIM(xdata, i) != dim)) ?
+                0 : PyArray_STRIDE(xdata, i);
+            lanes.yistrides[j] = (PyArray_DIM(data, i) != dim) ?
+                0 : PyArray_STRIDE(data, i);
+            lanes.xostrides[j] = ((PyArray_NDIM(xout) == 1)
+                || (PyArray_DIM(xout, i) != dim)) ?
+                0 : PyArray_STRIDE(xout, i);
+            lanes.yostrides[j] = PyArray_STRIDE(out, i);
+            lanes.count *= dim;
+            lanes.ndim++;
+        }
+    }
+
+    if ((workspace != NULL) && (lanes.count > 0)) {
+        bufsize = size;
+        buffer = workspace_take((WorkspaceObject *)workspace, &bufsize);
+        if (buffer == NULL) {
+            PyErr_Format(PyExc_ValueError, "failed to allocate output buffer");
+            goto _fail;
+        }
+    }
+
+    work.run = interpolate_lanes;
+    work.address = lane_address;
+    work.arg = &lanes;
+    work.count = lanes.count;
+    work.size = size;
+
+    if (stats != NULL) {
+        t1 = monotonic_ns();
+        STATS_ADD(&stats->counters[STATS_CONVERT_NS], t1 - t0);
+        for (i = 0; i < 3; i++) {
+            PyObject *array = (i == 0) ? (PyObject *)xdata :
+                              (i == 1) ? (PyObject *)data : (PyObject *)xout;
+            if (array != values[i]) {
+                STATS_ADD(&stats->counters[STATS_CONVERSIONS], 1);
+                STATS_ADD(&stats->counters[STATS_BYTES_COPIED],
+                          (long long)PyArray_NBYTES((PyArrayObject *)array));
+            }
+        }
+    }
+
+    AKIMA_PROBE8(interpolate__entry, size, outsize, axis, lanes.count,
+                 lanes.dxi, lanes.dyi, lanes.dxo, lanes.dyo);
+    error = 0;
+    if (work.count > 0) {
+        NPY_BEGIN_THREADS;
+        error = run_threaded(&work, maxworkers, buffer);
+        NPY_END_THREADS;
+    }
+    AKIMA_PROBE2(interpolate__return, lanes.count, error);
+
+    if (stats != NULL) {
+        STATS_ADD(&stats->counters[STATS_CALLS], 1);
+        STATS_ADD(&stats->counters[STATS_LANES], (long long)lanes.count);
+        STATS_ADD(&stats->counters[STATS_POINTS],
+                  (long long)lanes.count * size);
+        STATS_ADD(&stats->counters[STATS_OUTPOINTS],
+                  (long long)lanes.count * outsize);
+        STATS_ADD(&stats->counters[STATS_TOTAL_NS], monotonic_ns() - t0);
+    }
+
+    if (buffer != NULL) {
+        workspace_give((WorkspaceObject *)workspace, buffer, bufsize);
+        buffer = NULL;
+    }
+
+    if (error == -2) {
         PyErr_Format(PyExc_ValueError, "failed to allocate output buffer");
         goto _fail;
     }
+    if (error != 0) {
+        PyErr_Format(PyExc_ValueError, "interpolate() failed");
+        goto _fail;
+    }
 
-    while (dit->index < dit->size) {
-        error = interpolate(
-            size,
-            PyArray_DATA(xdata), xdstride,
-            dit->dataptr, dstride,
-            outsize,
-            PyArray_DATA(xout), xostride,
-            oit->dataptr, ostride,
-            buffer);
+    Py_DECREF(data);
+    Py_DECREF(xout);
+    Py_DECREF(xdata);
 
-        if (error != 0) {
-            PyErr_Format(PyExc_ValueError, "interpolate() failed");
+    /* Return output vector if not provided as argument */
+    if (oout == NULL) {
+        return PyArray_Return(out);
+    } else {
+        Py_INCREF(Py_None);
+        return Py_None;
+    }
+
+  _fail:
+    Py_XDECREF(xdata);
+    Py_XDECREF(xout);
+    Py_XDECREF(data);
+    if (oout == NULL)
+        Py_XDECREF(out);
+    else
+        Py_XDECREF(oout);
+    return NULL;
+}
+
+
+/*
+Interpolate batch of independent problems using Akima's method.
+*/
+char py_interpolate_batch_doc[] =
+    "Return interpolated data of batch of independent problems.\n\n"
+    "x, y, and x_new are concatenated 1D arrays of all problems. "
+    "Problem i spans x[offsets[i]:offsets[i+1]] and "
+    "x_new[offsets_new[i]:offsets_new[i+1]]. "
+    "Offsets start at 0 and end at the size of the arrays.\n"
+    "Problems are interpolated in up to maxworkers threads "
+    "(default 1, 0 for number of CPUs).\n"
+    "The copy argument is handled as in interpolate.";
+
+static PyObject *
+py_interpolate_batch(
+    PyObject *obj,
+    PyObject *const *args,
+    Py_ssize_t nargs,
+    PyObject *kwnames)
+{
+    PyArrayObject *xdata = NULL;
+    PyArrayObject *data = NULL;
+    PyArrayObject *xout = NULL;
+    PyArrayObject *offsets = NULL;
+    PyArrayObject *offsets_new = NULL;
+    PyArrayObject *out = NULL;
+    PyArrayObject *oout = NULL;
+    PyObject *values[8];
+    batch_t batch;
+    work_t work;
+    npy_intp i, count, size, outsize;
+    int maxworkers = 1;
+    int error, copy;
+    NPY_BEGIN_THREADS_DEF;
+
+    static const char *const kwlist[] = {
+        "x", "y", "x_new", "offsets", "offsets_new", "out", "maxworkers",
+        "copy", NULL};
+
+    if (parse_fastcall(
+            "interpolate_batch", args, nargs, kwnames, kwlist, 5, values)
+        || parse_copy_mode(values[7], GETSTATE(obj)->copy_mode, &copy)
+        || !convert_input("interpolate_batch", "x", values[0], copy,
+                          (PyObject **)&xdata)
+        || !convert_input("interpolate_batch", "y", values[1], copy,
+                          (PyObject **)&data)
+        || !convert_input("interpolate_batch", "x_new", values[2], copy,
+                          (PyObject **)&xout)
+        || !PyConverter_IntpArray(values[3], (PyObject **)&offsets)
+        || !PyConverter_IntpArray(values[4], (PyObject **)&offsets_new)
+        || !PyOutputConverter_AnyDoubleArrayOrNone(values[5], &oout))
+        goto _fail;
+
+    if (values[6] != NULL) {
+        long value = PyLong_AsLong(values[6]);
+        if ((value == -1) && PyErr_Occurred())
+            goto _fail;
+        maxworkers = (value > INT_MAX) ? INT_MAX : (int)value;
+    }
+
+    if ((PyArray_NDIM(xdata) != 1) || (PyArray_NDIM(data) != 1)
+        || (PyArray_NDIM(xout) != 1) || (PyArray_NDIM(offsets) != 1)
+        || (PyArray_NDIM(offsets_new) != 1)) {
+        PyErr_Format(PyExc_ValueError, "arrays must be one dimensional");
+        goto _fail;
+    }
+
+    size = PyArray_DIM(xdata, 0);
+    outsize = PyArray_DIM(xout, 0);
+    count = PyArray_DIM(offsets, 0) - 1;
+
+    if (size != PyArray_DIM(data, 0)) {
+        PyErr_Format(PyExc_ValueError, "size of x and y arrays must match");
+        goto _fail;
+    }
+
+    if ((count < 0) || (count != PyArray_DIM(offsets_new, 0) - 1)) {
+        PyErr_Format(PyExc_ValueError, "invalid size of offsets arrays");
+        goto _fail;
+    }
+
+    batch.offsets = (const npy_intp *)PyArray_DATA(offsets);
+    batch.offsets_new = (const npy_intp *)PyArray_DATA(offsets_new);
+
+    if ((batch.offsets[0] != 0) || (batch.offsets[count] != size)
+        || (batch.offsets_new[0] != 0)
+        || (batch.offsets_new[count] != outsize)) {
+        PyErr_Format(PyExc_ValueError,
+            "offsets must start at 0 and end at size of arrays");
+        goto _fail;
+    }
+
+    work.size = 0;
+    for (i = 0; i < count; i++) {
+        npy_intp n = batch.offsets[i + 1] - batch.offsets[i];
+        if (n < 3) {
+            PyErr_Format(PyExc_ValueError,
+                "size of problem %zd is too small", (Py_ssize_t)i);
+            goto _fail;
+        }
+        if (batch.offsets_new[i + 1] < batch.offsets_new[i]) {
+            PyErr_Format(PyExc_ValueError,
+                "offsets_new must be monotonically increasing");
             goto _fail;
         }
+        if (n > work.size) {
+            work.size = n;
+        }
+    }
+
+    if (oout == NULL) {
+        /* create a new output array */
+        out = (PyArrayObject*)PyArray_SimpleNew(1, &outsize, NPY_DOUBLE);
+        if (out == NULL) {
+            PyErr_Format(PyExc_ValueError, "failed to allocate output array");
+            goto _fail;
+        }
+    } else if ((PyArray_NDIM(oout) != 1)
+               || (PyArray_DIM(oout, 0) != outsize)) {
+        PyErr_Format(PyExc_ValueError, "wrong output shape");
+        goto _fail;
+    } else {
+        out = oout;
+    }
+
+    batch.xi = PyArray_DATA(xdata);
+    batch.dxi = PyArray_STRIDE(xdata, 0);
+    batch.yi = PyArray_DATA(data);
+    batch.dyi = PyArray_STRIDE(data, 0);
+    batch.xo = PyArray_DATA(xout);
+    batch.dxo = PyArray_STRIDE(xout, 0);
+    batch.yo = PyArray_DATA(out);
+    batch.dyo = PyArray_STRIDE(out, 0);
 
-        PyArray_ITER_NEXT(oit);
-        PyArray_ITER_NEXT(dit);
+    work.run = interpolate_batch;
+    work.address = batch_address;
+    work.arg = &batch;
+    work.count = count;
+
+    error = 0;
+    if (work.count > 0) {
+        NPY_BEGIN_THREADS;
+        error = run_threaded(&work, maxworkers, NULL);
+        NPY_END_THREADS;
     }
 
-    PyMem_Free(buffer);
-    Py_DECREF(oit);
-    Py_DECREF(dit);
+    if (error == -2) {
+        PyErr_Format(PyExc_ValueError, "failed to allocate output buffer");
+        goto _fail;
+    }
+    if (error != 0) {
+        PyErr_Format(PyExc_ValueError, "interpolate() failed");
+        goto _fail;
+    }
+
+    Py_DECREF(offsets_new);
+    Py_DECREF(offsets);
     Py_DECREF(data);
     Py_DECREF(xout);
     Py_DECREF(xdata);
@@ -391,10 +1461,8 @@ py_interpolate(
     Py_XDECREF(xdata);
     Py_XDECREF(xout);
     Py_XDECREF(data);
-    Py_XDECREF(oit);
-    Py_XDECREF(dit);
-    if (buffer != NULL)
-        PyMem_Free(buffer);
+    Py_XDECREF(offsets);
+    Py_XDECREF(offsets_new);
     if (oout == NULL)
         Py_XDECREF(out);
     else
@@ -403,72 +1471,311 @@ py_interpolate(
 }
 
 
+/*
+Return and optionally reset or enable call statistics.
+*/
+char py_stats_doc[] =
+    "stats(enable=None, reset=False)\n\n"
+    "Return dict of statistics of interpolate calls.\n\n"
+    "Counts calls, lanes, input and output points, input arrays copied by "
+    "converters and their bytes, and nanoseconds spent converting "
+    "arguments, computing coefficients, evaluating, and in total. "
+    "Coefficient and evaluation times are summed over threads.\n"
+    "Statistics are collected only if enabled, or if the AKIMA_STATS "
+    "environment variable is set at import. "
+    "If reset is True, counters are set to zero after reading.";
+
+static PyObject *
+py_stats(
+    PyObject *obj,
+    PyObject *const *args,
+    Py_ssize_t nargs,
+    PyObject *kwnames)
+{
+    stats_t *stats = &GETSTATE(obj)->stats;
+    long long *counters = stats->counters;
+    PyObject *values[2];
+    PyObject *result, *value;
+    long long count;
+    int i, enable = -1, reset = 0;
+
+    static const char *const kwlist[] = {"enable", "reset", NULL};
+
+    if (parse_fastcall("stats", args, nargs, kwnames, kwlist, 0, values))
+        return NULL;
+    if ((values[0] != NULL) && (values[0] != Py_None)) {
+        enable = PyObject_IsTrue(values[0]);
+        if (enable < 0)
+            return NULL;
+    }
+    if (values[1] != NULL) {
+        reset = PyObject_IsTrue(values[1]);
+        if (reset < 0)
+            return NULL;
+    }
+
+    if (enable >= 0) {
+        STATS_EXCHANGE(&stats->enabled, (long long)enable);
+    }
+    result = PyDict_New();
+    if (result == NULL)
+        return NULL;
+    value = PyBool_FromLong((long)STATS_LOAD(&stats->enabled));
+    if (PyDict_SetItemString(result, "enabled", value) < 0) {
+        Py_DECREF(value);
+        Py_DECREF(result);
+        return NULL;
+    }
+    Py_DECREF(value);
+    for (i = 0; i < STATS_FIELDS; i++) {
+        if (reset) {
+            count = STATS_EXCHANGE(&counters[i], 0LL);
+        } else {
+            count = STATS_LOAD(&counters[i]);
+        }
+        value = PyLong_FromLongLong(count);
+        if ((value == NULL)
+            || (PyDict_SetItemString(result, stats_names[i], value) < 0)) {
+            Py_XDECREF(value);
+            Py_DECREF(result);
+            return NULL;
+        }
+        Py_DECREF(value);
+    }
+    return result;
+}
+
+
 /*****************************************************************************/
-/* Python module */
+/* Generalized universal function */
 
-static PyMethodDef module_methods[] = {
-    {"interpolate", (PyCFunction)py_interpolate, METH_VARARGS|METH_KEYWORDS,
-        py_interpolate_doc},
-    {NULL, NULL, 0, NULL} /* Sentinel */
+/*
+Set Python exception from gufunc loop, which may run without the GIL.
+*/
+static void
+gufunc_error(PyObject *type, const char *msg)
+{
+    NPY_ALLOW_C_API_DEF
+    NPY_ALLOW_C_API;
+    PyErr_SetString(type, msg);
+    NPY_DISABLE_C_API;
+}
+
+/* Kernel of the gufunc inner loop, akima_interpolate or akima_interpolate_f */
+typedef int (*gufunc_kernel_t)(
+    ptrdiff_t, const char *, ptrdiff_t, const char *, ptrdiff_t,
+    ptrdiff_t, const char *, ptrdiff_t, char *, ptrdiff_t, double *);
+
+typedef struct {
+    gufunc_kernel_t kernel;
+} gufunc_kernel_data_t;
+
+static const gufunc_kernel_data_t gufunc_kernel_float = {akima_interpolate_f};
+static const gufunc_kernel_data_t gufunc_kernel_double = {akima_interpolate};
+
+/*
+Inner loop of gufunc with signature (n),(n),(m)->(m).
+The data argument selects the float32 or float64 kernel, which operate
+directly on the strided lanes.
+*/
+static void
+gufunc_interpolate(
+    char **args,
+    npy_intp const *dimensions,
+    npy_intp const *steps,
+    void *data)
+{
+    npy_intp i;
+    npy_intp count = dimensions[0];
+    npy_intp size = dimensions[1];
+    npy_intp outsize = dimensions[2];
+    gufunc_kernel_t kernel = ((const gufunc_kernel_data_t *)data)->kernel;
+    double *buffer;
+
+    if (size < 3) {
+        gufunc_error(PyExc_ValueError, "size along axis is too small");
+        return;
+    }
+    buffer = (double *)PyMem_RawMalloc(
+        AKIMA_BUFFER_SIZE(size) * sizeof(double));
+    if (buffer == NULL) {
+        gufunc_error(PyExc_MemoryError, "failed to allocate buffer");
+        return;
+    }
+    for (i = 0; i < count; i++) {
+        if (kernel(
+                size,
+                args[0] + i * steps[0], steps[4],
+                args[1] + i * steps[1], steps[5],
+                outsize,
+                args[2] + i * steps[2], steps[6],
+                args[3] + i * steps[3], steps[7],
+                buffer) != 0) {
+            gufunc_error(PyExc_ValueError, "interpolate() failed");
+            break;
+        }
+    }
+    PyMem_RawFree(buffer);
+}
+
+static PyUFuncGenericFunction gufunc_funcs[] = {
+    gufunc_interpolate,
+    gufunc_interpolate
 };
 
+static void *gufunc_data[] = {
+    (void *)&gufunc_kernel_float,
+    (void *)&gufunc_kernel_double
+};
 
-struct module_state {
-    PyObject *error;
+static const char gufunc_types[] = {
+    NPY_FLOAT, NPY_FLOAT, NPY_FLOAT, NPY_FLOAT,
+    NPY_DOUBLE, NPY_DOUBLE, NPY_DOUBLE, NPY_DOUBLE
 };
 
-#define GETSTATE(m) ((struct module_state*)PyModule_GetState(m))
+char gufunc_interpolate_doc[] =
+    "Return interpolated data along last axis using Akima's method.\n\n"
+    "Generalized ufunc with signature (n),(n),(m)->(m).";
+
+/*****************************************************************************/
+/* Python module */
+
+static PyMethodDef module_methods[] = {
+    {"interpolate", (PyCFunction)(void(*)(void))py_interpolate,
+        METH_FASTCALL|METH_KEYWORDS, py_interpolate_doc},
+    {"interpolate_batch", (PyCFunction)(void(*)(void))py_interpolate_batch,
+        METH_FASTCALL|METH_KEYWORDS, py_interpolate_batch_doc},
+    {"stats", (PyCFunction)(void(*)(void))py_stats,
+        METH_FASTCALL|METH_KEYWORDS, py_stats_doc},
+    {NULL, NULL, 0, NULL} /* Sentinel */
+};
 
-static int module_traverse(PyObject *m, visitproc visit, void *arg) {
-    Py_VISIT(GETSTATE(m)->error);
+static int
+module_traverse(PyObject *m, visitproc visit, void *arg)
+{
+    Py_VISIT(GETSTATE(m)->workspace_type);
     return 0;
 }
 
-static int module_clear(PyObject *m) {
-    Py_CLEAR(GETSTATE(m)->error);
+static int
+module_clear(PyObject *m)
+{
+    Py_CLEAR(GETSTATE(m)->workspace_type);
     return 0;
 }
 
+static void
+module_free(void *m)
+{
+    module_clear((PyObject *)m);
+}
+
+/*
+The only module state is the Workspace type and the call statistics,
+which are updated atomically. The kernel works on caller provided arrays
+and buffers, and the GIL is released while interpolating.
+The C API table exported in a capsule is constant.
+The NumPy C API table imported in module_exec is the same for all
+interpreters, hence the module can be loaded in isolated subinterpreters.
+*/
+static int
+module_exec(PyObject *module)
+{
+    struct module_state *state = GETSTATE(module);
+    PyObject *ufunc, *capsule;
+
+    if (_import_array() < 0) {
+        return -1;
+    }
+    if (_import_umath() < 0) {
+        return -1;
+    }
+    ufunc = PyUFunc_FromFuncAndDataAndSignature(
+        gufunc_funcs, gufunc_data, (char *)gufunc_types, 2, 3, 1,
+        PyUFunc_None, "interpolate_gufunc", gufunc_interpolate_doc, 0,
+        "(n),(n),(m)->(m)");
+    if (ufunc == NULL) {
+        return -1;
+    }
+    if (PyModule_AddObjectRef(module, "interpolate_gufunc", ufunc) < 0) {
+        Py_DECREF(ufunc);
+        return -1;
+    }
+    Py_DECREF(ufunc);
+    {
+        /* enable call statistics at import */
+        const char *env = getenv("AKIMA_STATS");
+        state->stats.enabled = (env != NULL) && (env[0] != '\0') &&
+                               (strcmp(env, "0") != 0);
+        /* default handling of input conversions */
+        env = getenv("AKIMA_COPY");
+        state->copy_mode = COPY_ALLOW;
+        if (env != NULL) {
+            if (strcmp(env, "warn") == 0) {
+                state->copy_mode = COPY_WARN;
+            } else if (strcmp(env, "never") == 0) {
+                state->copy_mode = COPY_NEVER;
+            }
+        }
+    }
+    state->workspace_type = PyType_FromModuleAndSpec(
+        module, &workspace_spec, NULL);
+    if (state->workspace_type == NULL) {
+        return -1;
+    }
+    if (PyModule_AddObjectRef(
+            module, "Workspace", state->workspace_type) < 0) {
+        return -1;
+    }
+    capsule = PyCapsule_New(
+        (void *)&akima_capi_table, AKIMA_CAPI_NAME, NULL);
+    if (capsule == NULL) {
+        return -1;
+    }
+    if (PyModule_AddObjectRef(module, AKIMA_CAPI_ATTR, capsule) < 0) {
+        Py_DECREF(capsule);
+        return -1;
+    }
+    Py_DECREF(capsule);
+    if (PyModule_AddStringConstant(module, "__version__", _VERSION_) < 0) {
+        return -1;
+    }
+    if (PyModule_AddStringConstant(
+            module, "cpu_target", akima_cpu_target()) < 0) {
+        return -1;
+    }
+    if (PyModule_AddStringConstant(
+            module, "fp_mode", akima_fp_mode()) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+static PyModuleDef_Slot module_slots[] = {
+    {Py_mod_exec, module_exec},
+#if PY_VERSION_HEX >= 0x030C0000
+    {Py_mod_multiple_interpreters, Py_MOD_PER_INTERPRETER_GIL_SUPPORTED},
+#endif
+#if PY_VERSION_HEX >= 0x030D0000
+    {Py_mod_gil, Py_MOD_GIL_NOT_USED},
+#endif
+    {0, NULL} /* Sentinel */
+};
+
 static struct PyModuleDef moduledef = {
     PyModuleDef_HEAD_INIT,
     "_akima",
-    NULL,
+    _DOC_,
     sizeof(struct module_state),
     module_methods,
-    NULL,
+    module_slots,
     module_traverse,
     module_clear,
-    NULL
+    module_free
 };
 
 PyMODINIT_FUNC
 PyInit__akima(void)
 {
-    PyObject *module;
-
-    char *doc = (char *)PyMem_Malloc(sizeof(_DOC_) + sizeof(_VERSION_));
-    PyOS_snprintf(doc, sizeof(_DOC_) + sizeof(_VERSION_), _DOC_, _VERSION_);
-
-    moduledef.m_doc = doc;
-    module = PyModule_Create(&moduledef);
-
-    PyMem_Free(doc);
-
-    if (module == NULL) {
-        return NULL;
-    }
-
-    if (_import_array() < 0) {
-        Py_DECREF(module);
-        return NULL;
-    }
-
-    {
-    PyObject *s = PyUnicode_FromString(_VERSION_);
-    PyObject *dict = PyModule_GetDict(module);
-    PyDict_SetItemString(dict, "__version__", s);
-    Py_DECREF(s);
-    }
-
-    return module;
+    return PyModuleDef_Init(&moduledef);
 }
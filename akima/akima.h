@@ -0,0 +1,183 @@
+/* akima.h
+
+Akima interpolation library.
+
+Interpolate data points in a plane based on Akima's method:
+
+    A new method of interpolation and smooth curve fitting based on local
+    procedures. Hiroshi Akima, J. ACM, October 1970, 17(4), 589-602.
+
+Arrays are of type double and addressed by pointer to the first element
+and stride in bytes. Output x coordinates must be monotonically
+increasing. Functions returning int return 0 on success or -1 if input
+x coordinates are not monotonically increasing.
+
+The functions do not use global state and are thread-safe.
+
+Copyright (c) 2007-2025, Christoph Gohlke
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+   contributors may be used to endorse or promote products derived from
+   this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef AKIMA_H
+#define AKIMA_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AKIMA_VERSION "2026.x.x"
+
+#if defined(AKIMA_SHARED_LIBRARY)
+#if defined(_WIN32)
+#if defined(AKIMA_BUILDING_LIBRARY)
+#define AKIMA_API __declspec(dllexport)
+#else
+#define AKIMA_API __declspec(dllimport)
+#endif
+#else
+#define AKIMA_API __attribute__((visibility("default")))
+#endif
+#else
+#define AKIMA_API
+#endif
+
+/* Number of doubles in buffer for input arrays of size n */
+#define AKIMA_BUFFER_SIZE(n) ((n) * 4 + 4)
+
+/* Opaque Akima sub-spline */
+typedef struct akima_spline akima_spline;
+
+/*
+Interpolate si input points at so output points.
+The buffer must hold AKIMA_BUFFER_SIZE(si) doubles.
+*/
+AKIMA_API int
+akima_interpolate(
+    ptrdiff_t si,
+    const char *xi, ptrdiff_t dxi,
+    const char *yi, ptrdiff_t dyi,
+    ptrdiff_t so,
+    const char *xo, ptrdiff_t dxo,
+    char *yo, ptrdiff_t dyo,
+    double *buffer);
+
+/*
+Compute polynomial coefficients into buffer of AKIMA_BUFFER_SIZE(si) doubles.
+*/
+AKIMA_API int
+akima_coefficients(
+    ptrdiff_t si,
+    const char *xi, ptrdiff_t dxi,
+    const char *yi, ptrdiff_t dyi,
+    double *buffer);
+
+/*
+Evaluate polynomial coefficients at output x coordinates.
+*/
+AKIMA_API void
+akima_evaluate(
+    ptrdiff_t si,
+    const char *xi, ptrdiff_t dxi,
+    const double *buffer,
+    ptrdiff_t so,
+    const char *xo, ptrdiff_t dxo,
+    char *yo, ptrdiff_t dyo);
+
+/*
+Single precision variants of akima_interpolate, akima_coefficients, and
+akima_evaluate. Input and output coordinates are float. Computations and
+polynomial coefficients are double precision.
+*/
+AKIMA_API int
+akima_interpolate_f(
+    ptrdiff_t si,
+    const char *xi, ptrdiff_t dxi,
+    const char *yi, ptrdiff_t dyi,
+    ptrdiff_t so,
+    const char *xo, ptrdiff_t dxo,
+    char *yo, ptrdiff_t dyo,
+    double *buffer);
+
+AKIMA_API int
+akima_coefficients_f(
+    ptrdiff_t si,
+    const char *xi, ptrdiff_t dxi,
+    const char *yi, ptrdiff_t dyi,
+    double *buffer);
+
+AKIMA_API void
+akima_evaluate_f(
+    ptrdiff_t si,
+    const char *xi, ptrdiff_t dxi,
+    const double *buffer,
+    ptrdiff_t so,
+    const char *xo, ptrdiff_t dxo,
+    char *yo, ptrdiff_t dyo);
+
+/*
+Return new spline through input points or NULL if size is too small,
+x coordinates are not monotonically increasing, or out of memory.
+*/
+AKIMA_API akima_spline *
+akima_spline_create(
+    ptrdiff_t si,
+    const char *xi, ptrdiff_t dxi,
+    const char *yi, ptrdiff_t dyi);
+
+/*
+Evaluate spline at output x coordinates.
+*/
+AKIMA_API void
+akima_spline_evaluate(
+    const akima_spline *spline,
+    ptrdiff_t so,
+    const char *xo, ptrdiff_t dxo,
+    char *yo, ptrdiff_t dyo);
+
+AKIMA_API void
+akima_spline_destroy(akima_spline *spline);
+
+/*
+Return name of CPU target selected at load time for the kernels.
+*/
+AKIMA_API const char *
+akima_cpu_target(void);
+
+/*
+Return floating point mode of the kernels, "fma" or "strict".
+*/
+AKIMA_API const char *
+akima_fp_mode(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AKIMA_H */
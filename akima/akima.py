@@ -47,7 +47,7 @@ This module is no longer being actively developed. Consider using
 
 :Author: `Christoph Gohlke <https://www.cgohlke.com>`_
 :License: BSD 3-Clause
-:Version: 2025.1.1
+:Version: 2026.x.x
 
 Quickstart
 ----------
@@ -74,6 +74,40 @@ This revision was tested with the following requirements and dependencies
 Revisions
 ---------
 
+2026.x.x
+
+- Support free-threaded Python (Py_MOD_GIL_NOT_USED).
+- Use multi-phase module initialization.
+- Support subinterpreters with per-interpreter GIL.
+- Release the GIL while interpolating.
+- Add interpolate_async function.
+- Interpolate lanes in NUMA-aware threads (maxworkers).
+- Add interpolate_chunked function for large memory-mapped arrays.
+- Add Workspace type to reuse buffers across interpolate calls.
+- Reduce call overhead of C interpolate function (METH_FASTCALL).
+- Fix C interpolate function with byte-swapped or unaligned float64 input.
+- Add interpolate_batch function for many independent small problems.
+- Support N-D x and x_new broadcast against y in C interpolate function.
+- Add interpolate_gufunc generalized ufunc for float32 and float64.
+- Export C API in capsule (akima_capi.h).
+- Move kernel to Python-free libakima C library (akima.h) with CMake build.
+- Add float32 kernel to libakima (akima_interpolate_f) using a type template.
+- Add contiguous specializations of the kernel that compilers can vectorize.
+- Select kernels for x86-64-v3 or v4 CPUs at runtime (GCC on Linux).
+- Add show_config function.
+- Evaluate polynomials in Horner form per run of output points in interval.
+- Add AKIMA_STRICT_FP build option to disable fused multiply-add.
+- Compute weighted slopes without branches or loop-carried dependencies.
+- Build profile-guided and link-time optimized with AKIMA_PGO=1 (GCC).
+- Add asv compatible benchmarks.
+- Add akima_bench native micro-benchmark of kernel phases (CMake).
+- Count hardware events per kernel phase in akima_bench (Linux).
+- Add stats function to count and time interpolate calls.
+- Add USDT probes if sys/sdt.h is available (akima_probes.h).
+- Add copy argument and AKIMA_COPY variable to forbid or warn about copies.
+- Do not copy float64 arrays in interpolate_py.
+- Add differential fuzzers comparing kernels and functions to references.
+
 2025.1.1
 
 - Drop support for Python 3.9, support Python 3.13.
@@ -118,16 +152,28 @@ Examples
 
 from __future__ import annotations
 
-__version__ = '2025.1.1'
+__version__ = '2026.x.x'
 
-__all__ = ['__version__', 'interpolate']
+__all__ = [
+    '__version__',
+    'get_include',
+    'interpolate',
+    'interpolate_async',
+    'interpolate_chunked',
+    'show_config',
+]
 
 
+import asyncio
+import functools
+import mmap
+import os
 from typing import TYPE_CHECKING
 
 import numpy
 
 if TYPE_CHECKING:
+    from concurrent.futures import Executor
     from typing import Any
 
     from numpy.typing import ArrayLike, NDArray
@@ -141,6 +187,7 @@ def interpolate(
     *,
     axis: int = -1,
     out: NDArray[Any] | None = None,
+    copy: bool | str | None = None,
 ) -> NDArray[Any]:
     """Return interpolated data using Akima's method.
 
@@ -163,6 +210,14 @@ def interpolate(
         out:
             Optional array to receive results. Dimension at axis must equal
             length of x.
+        copy:
+            Handling of inputs that are not float64 arrays and must be
+            copied. The C implementation also copies unaligned and
+            byte-swapped arrays.
+            If False or 'never', raise ValueError.
+            If 'warn', issue RuntimeWarning.
+            If None (default), use the AKIMA_COPY environment variable.
+            Else, copy silently.
 
     Examples:
         >>> import numpy
@@ -181,9 +236,9 @@ def interpolate(
         True
 
     """
-    x = numpy.array(x, dtype=numpy.float64, copy=True)
-    y = numpy.array(y, dtype=numpy.float64, copy=True)
-    xi = numpy.array(x_new, dtype=numpy.float64, copy=True)
+    x = _asfloat64(x, 'x', copy)
+    y = _asfloat64(y, 'y', copy)
+    xi = _asfloat64(x_new, 'x_new', copy)
 
     if axis != -1 or out is not None or y.ndim != 1:
         raise NotImplementedError('implemented in C extension module')
@@ -232,21 +287,316 @@ def interpolate(
     return numpy.asarray(((wj * d[bb] + c[bb]) * wj + b[bb]) * wj + y[bb])
 
 
+def _asfloat64(
+    a: ArrayLike, name: str, copy: bool | str | None, /
+) -> NDArray[Any]:
+    """Return input as float64 array, copying according to copy mode."""
+    forbids = f'copy={copy!r}'
+    if copy is None:
+        copy = os.environ.get('AKIMA_COPY')
+        forbids = f'AKIMA_COPY={copy}'
+    elif copy not in {True, False, 'warn', 'never'}:
+        raise ValueError("copy must be None, True, False, 'warn', or 'never'")
+    if isinstance(a, numpy.ndarray) and a.dtype == numpy.float64:
+        return a
+    if copy is False or copy == 'never':
+        raise ValueError(
+            f'interpolate() would copy {name} to float64 array, '
+            f'which {forbids} forbids'
+        )
+    a = numpy.asarray(a, dtype=numpy.float64)
+    if copy == 'warn':
+        import warnings
+
+        warnings.warn(
+            f'interpolate() copied {name} to float64 array '
+            f'of {a.nbytes} bytes',
+            RuntimeWarning,
+            stacklevel=3,
+        )
+    return a
+
+
+async def interpolate_async(
+    x: ArrayLike,
+    y: ArrayLike,
+    x_new: ArrayLike,
+    /,
+    *,
+    executor: Executor | None = None,
+    **kwargs: Any,
+) -> NDArray[Any] | None:
+    """Return interpolated data using Akima's method without blocking.
+
+    The interpolation is run in a worker thread of `executor` while the
+    event loop continues to serve other tasks. The C extension module
+    releases the GIL during interpolation.
+
+    Parameters:
+        x, y, x_new:
+            Passed to :py:func:`interpolate`.
+        executor:
+            Executor used to run the interpolation.
+            By default, use the event loop's default executor.
+        **kwargs:
+            Keyword arguments passed to :py:func:`interpolate`,
+            for example `axis` or `out`.
+
+    Examples:
+        >>> import asyncio
+        >>> asyncio.run(interpolate_async([0, 1, 2], [0, 0, 1], [0.5, 1.5]))
+        array([-0.125,  0.375])
+        >>> y = numpy.array([[0, 0], [0, 1], [1, 4]])
+        >>> asyncio.run(interpolate_async([0, 1, 2], y, [0.5, 1.5], axis=0))
+        array([[-0.125,  0.25 ],
+               [ 0.375,  2.25 ]])
+
+    """
+    loop = asyncio.get_running_loop()
+    return await loop.run_in_executor(
+        executor,
+        functools.partial(interpolate, x, y, x_new, **kwargs),
+    )
+
+
+def interpolate_chunked(
+    x: ArrayLike,
+    y: ArrayLike,
+    x_new: ArrayLike,
+    /,
+    *,
+    axis: int = -1,
+    out: NDArray[Any] | None = None,
+    chunksize: int = 2**26,
+) -> NDArray[Any] | None:
+    """Return interpolated data using Akima's method in chunks.
+
+    Interpolate large, for example memory-mapped, arrays with bounded
+    memory. `y` is processed in blocks of about `chunksize` bytes along its
+    outermost dimension. If that is the interpolation axis, for example
+    for 1D `y` or `axis=0` of C-contiguous `y`, the blocks are overlapping
+    windows of consecutive samples. Else, the blocks are sets of lanes.
+    Blocks are converted to float64 and written to `out` one at a time.
+    For numpy.memmap `y`, the next block is prefetched with
+    ``madvise(MADV_WILLNEED)`` while the current block is interpolated.
+
+    The pure Python implementation does not support output arrays.
+    Without the C extension module, NotImplementedError is raised.
+
+    Parameters:
+        x, y, x_new, axis:
+            Passed to :py:func:`interpolate`.
+        out:
+            Optional array to receive results, for example a numpy.memmap.
+            If None, a new array is returned, else None.
+        chunksize:
+            Approximate number of bytes of `y`, and of float64 results,
+            to process per block.
+
+    Examples:
+        >>> x = numpy.arange(100.0)
+        >>> y = numpy.sin(x * 0.1).reshape(1, -1).repeat(8, 0)
+        >>> x_new = numpy.linspace(0, 99, 300)
+        >>> z = interpolate_chunked(x, y, x_new, chunksize=1024)
+        >>> numpy.array_equal(z, interpolate(x, y, x_new))
+        True
+        >>> z = interpolate_chunked(x, y.T, x_new, axis=0, chunksize=1024)
+        >>> numpy.array_equal(z, interpolate(x, y.T, x_new, axis=0))
+        True
+        >>> z = interpolate_chunked(x, y[0], x_new, chunksize=256)
+        >>> numpy.array_equal(z, interpolate(x, y[0], x_new))
+        True
+
+    """
+    if 'interpolate_py' not in globals():
+        # the C extension module failed to import
+        raise NotImplementedError('implemented in C extension module')
+    x = numpy.asarray(x, dtype=numpy.float64)
+    x_new = numpy.asarray(x_new, dtype=numpy.float64)
+    if not isinstance(y, numpy.ndarray):
+        y = numpy.asarray(y)
+    if x.ndim != 1 or x_new.ndim != 1:
+        raise ValueError('x-arrays must be one dimensional')
+    axis = axis % y.ndim
+    if x.size != y.shape[axis]:
+        raise ValueError('size of x-array must match data shape')
+    shape = list(y.shape)
+    shape[axis] = x_new.size
+    ret = out is None
+    if out is None:
+        out = numpy.empty(shape, dtype=numpy.float64)
+    elif list(out.shape) != shape:
+        raise ValueError('wrong output shape')
+    chunksize = max(int(chunksize), 1)
+    if y.size == 0 or x_new.size == 0:
+        interpolate(x, y, x_new, axis=axis, out=out)
+        return out if ret else None
+
+    # block along the dimension with the largest stride, such that blocks
+    # of memory-mapped y are contiguous ranges of pages
+    dim = max(
+        (i for i in range(y.ndim) if y.shape[i] > 1 or i == axis),
+        key=lambda i: abs(y.strides[i]) if y.shape[i] > 1 else -1,
+    )
+    index: list[Any] = [slice(None)] * y.ndim
+
+    if dim != axis:
+        # walk sets of lanes
+        step = max(chunksize // (y.nbytes // y.shape[dim]), 1)
+        starts = list(range(0, y.shape[dim], step))
+        for i, start in enumerate(starts):
+            if i + 1 < len(starts):
+                index[dim] = slice(starts[i + 1], starts[i + 1] + step)
+                _madvise_willneed(y[tuple(index)])
+            index[dim] = slice(start, start + step)
+            interpolate(
+                x, y[tuple(index)], x_new, axis=axis, out=out[tuple(index)]
+            )
+        return out if ret else None
+
+    # walk the interpolation axis in windows of samples. Window k
+    # evaluates x_new in [x[knots[k]], x[knots[k+1]]). The polynomial of
+    # interval i depends on y[i-2:i+4], so windows overlap by 7 samples.
+    n = x.size
+    step = max(chunksize // (y.nbytes // n), 1)
+    knots = list(range(0, n - 1, step))
+    knots.append(n - 1)
+    windows = [
+        slice(max(knots[k] - 3, 0), min(knots[k + 1] + 4, n))
+        for k in range(len(knots) - 1)
+    ]
+    # x_new must be monotonically increasing as for interpolate
+    edges = numpy.searchsorted(x_new, x[knots[1:-1]]).tolist()
+    edges = [0] + edges + [x_new.size]
+    # number of output points per block
+    ostep = max(chunksize // (out.nbytes // x_new.size), 1)
+    for k, window in enumerate(windows):
+        if k + 1 < len(windows):
+            index[axis] = windows[k + 1]
+            _madvise_willneed(y[tuple(index)])
+        index[axis] = window
+        yw = y[tuple(index)]
+        for start in range(edges[k], edges[k + 1], ostep):
+            index[axis] = slice(start, min(start + ostep, edges[k + 1]))
+            interpolate(
+                x[window],
+                yw,
+                x_new[index[axis]],
+                axis=axis,
+                out=out[tuple(index)],
+            )
+    return out if ret else None
+
+
+def _madvise_willneed(a: NDArray[Any], /) -> None:
+    """Advise kernel to read ahead pages of memory-mapped array."""
+    mm = getattr(a, '_mmap', None)
+    if mm is None or a.size == 0 or not hasattr(mmap, 'MADV_WILLNEED'):
+        return
+    try:
+        base = numpy.frombuffer(mm, dtype=numpy.uint8).ctypes.data
+    except (TypeError, ValueError):
+        return
+    data = a.__array_interface__['data'][0]
+    low = data + sum(min(0, (i - 1) * s) for i, s in zip(a.shape, a.strides))
+    high = data + a.itemsize
+    high += sum(max(0, (i - 1) * s) for i, s in zip(a.shape, a.strides))
+    offset = low - base
+    offset -= offset % mmap.PAGESIZE
+    try:
+        mm.madvise(mmap.MADV_WILLNEED, offset, high - base - offset)
+    except (OSError, ValueError):
+        pass
+
+
+def get_include() -> str:
+    """Return directory containing the akima_capi.h C header file.
+
+    The header declares the C API exported by the _akima extension module
+    for use by other C extension modules.
+
+    """
+    return os.path.dirname(os.path.abspath(__file__))
+
+
+def show_config() -> None:
+    """Print versions and build configuration of akima.
+
+    The CPU target is the instruction set level, for which the C kernels
+    were selected at import time. The FP mode is "fma" if the kernels may
+    use fused multiply-add instructions or "strict" if the library was
+    built with AKIMA_STRICT_FP.
+
+    """
+    import platform
+    import sys
+
+    try:
+        from . import _akima
+    except ImportError:
+        try:
+            import _akima  # type: ignore[no-redef]
+        except ImportError:
+            _akima = None  # type: ignore[assignment]
+
+    if hasattr(os, 'sched_getaffinity'):
+        cpu_count = len(os.sched_getaffinity(0))
+    else:
+        cpu_count = os.cpu_count() or 1
+    gil = getattr(sys, '_is_gil_enabled', lambda: True)()
+    config = [
+        ('akima', __version__),
+        ('numpy', numpy.__version__),
+        ('python', sys.version.split()[0]),
+        ('platform', platform.platform()),
+        ('machine', platform.machine()),
+        ('GIL enabled', gil),
+        ('CPU count', cpu_count),
+    ]
+    if _akima is None:
+        config.append(('C extension', 'not available'))
+    else:
+        config.append(('C extension', _akima.__file__))
+        config.append(('CPU target', _akima.cpu_target))
+        config.append(('FP mode', _akima.fp_mode))
+    for key, value in config:
+        print(f'{key + ":":<13} {value}')
+
+
 interpolate_py = interpolate
+_c_all = [
+    'interpolate_py',
+    'interpolate_batch',
+    'interpolate_gufunc',
+    'stats',
+    'Workspace',
+]
 try:
-    from ._akima import interpolate  # type: ignore[no-redef]
+    from ._akima import (  # type: ignore[no-redef]
+        Workspace,
+        interpolate,
+        interpolate_batch,
+        interpolate_gufunc,
+        stats,
+    )
 except ImportError:
     try:
-        from _akima import interpolate  # type: ignore[no-redef]
+        from _akima import (  # type: ignore[no-redef]
+            Workspace,
+            interpolate,
+            interpolate_batch,
+            interpolate_gufunc,
+            stats,
+        )
     except ImportError:
         import warnings
 
         warnings.warn('failed to import the _akima C extension module')
         del interpolate_py
     else:
-        __all__.append('interpolate_py')
+        __all__.extend(_c_all)
 else:
-    __all__.append('interpolate_py')
+    __all__.extend(_c_all)
 
 
 if __name__ == '__main__':
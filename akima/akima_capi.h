@@ -0,0 +1,172 @@
+/* akima_capi.h
+
+C API of the akima._akima extension module.
+
+Other Python C extensions can call the Akima interpolation kernel without
+Python call overhead. The functions do not require the GIL.
+
+Usage:
+
+    #include "akima_capi.h"
+
+    if (akima_import() < 0) {
+        return NULL;
+    }
+    error = akima_capi->interpolate(...);
+
+Copyright (c) 2007-2025, Christoph Gohlke
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+   contributors may be used to endorse or promote products derived from
+   this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef AKIMA_CAPI_H
+#define AKIMA_CAPI_H
+
+#include "Python.h"
+#include "akima.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Incremented when functions are appended to the table */
+#define AKIMA_CAPI_VERSION 2
+
+#define AKIMA_CAPI_ATTR "_C_API"
+#define AKIMA_CAPI_NAME "akima._akima._C_API"
+
+/*
+Function table of the akima.h library functions.
+*/
+typedef struct {
+    int version;  /* AKIMA_CAPI_VERSION of the module */
+
+    /* akima_interpolate */
+    int (*interpolate)(
+        ptrdiff_t si,
+        const char *xi, ptrdiff_t dxi,
+        const char *yi, ptrdiff_t dyi,
+        ptrdiff_t so,
+        const char *xo, ptrdiff_t dxo,
+        char *yo, ptrdiff_t dyo,
+        double *buffer);
+
+    /* akima_coefficients */
+    int (*coefficients)(
+        ptrdiff_t si,
+        const char *xi, ptrdiff_t dxi,
+        const char *yi, ptrdiff_t dyi,
+        double *buffer);
+
+    /* akima_evaluate */
+    void (*evaluate)(
+        ptrdiff_t si,
+        const char *xi, ptrdiff_t dxi,
+        const double *buffer,
+        ptrdiff_t so,
+        const char *xo, ptrdiff_t dxo,
+        char *yo, ptrdiff_t dyo);
+
+    /* akima_spline_create */
+    akima_spline *(*spline_create)(
+        ptrdiff_t si,
+        const char *xi, ptrdiff_t dxi,
+        const char *yi, ptrdiff_t dyi);
+
+    /* akima_spline_evaluate */
+    void (*spline_evaluate)(
+        const akima_spline *spline,
+        ptrdiff_t so,
+        const char *xo, ptrdiff_t dxo,
+        char *yo, ptrdiff_t dyo);
+
+    /* akima_spline_destroy */
+    void (*spline_destroy)(akima_spline *spline);
+
+    /* version 2 */
+
+    /* akima_interpolate_f */
+    int (*interpolate_f)(
+        ptrdiff_t si,
+        const char *xi, ptrdiff_t dxi,
+        const char *yi, ptrdiff_t dyi,
+        ptrdiff_t so,
+        const char *xo, ptrdiff_t dxo,
+        char *yo, ptrdiff_t dyo,
+        double *buffer);
+
+    /* akima_coefficients_f */
+    int (*coefficients_f)(
+        ptrdiff_t si,
+        const char *xi, ptrdiff_t dxi,
+        const char *yi, ptrdiff_t dyi,
+        double *buffer);
+
+    /* akima_evaluate_f */
+    void (*evaluate_f)(
+        ptrdiff_t si,
+        const char *xi, ptrdiff_t dxi,
+        const double *buffer,
+        ptrdiff_t so,
+        const char *xo, ptrdiff_t dxo,
+        char *yo, ptrdiff_t dyo);
+} akima_capi_t;
+
+#ifndef AKIMA_CAPI_MODULE
+
+static const akima_capi_t *akima_capi = NULL;
+
+/*
+Import the C API table from akima._akima. Return 0 or -1 with exception set.
+Requires the GIL.
+*/
+static int
+akima_import(void)
+{
+    const akima_capi_t *capi;
+
+    capi = (const akima_capi_t *)PyCapsule_Import(AKIMA_CAPI_NAME, 0);
+    if (capi == NULL) {
+        return -1;
+    }
+    if (capi->version < AKIMA_CAPI_VERSION) {
+        PyErr_Format(PyExc_ImportError,
+            "akima C API version %i is older than %i",
+            capi->version, AKIMA_CAPI_VERSION);
+        return -1;
+    }
+    akima_capi = capi;
+    return 0;
+}
+
+#endif /* AKIMA_CAPI_MODULE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AKIMA_CAPI_H */
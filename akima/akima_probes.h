@@ -0,0 +1,96 @@
+/* akima_probes.h
+
+USDT probes of the akima library and Python extension module.
+
+Static tracepoints for tools like bpftrace, perf, or SystemTap. They are
+compiled in only if the sys/sdt.h header is available, for example from
+the systemtap-sdt-dev package, and cost a no-op instruction if not
+attached. Define AKIMA_NO_USDT to disable them.
+
+Probes of provider "akima":
+
+    interpolate__call()
+    interpolate__entry(n, m, axis, lanes, dxi, dyi, dxo, dyo)
+    interpolate__return(lanes, error)
+    lane__start(lane, n, m)
+    coefficients__entry(n, dxi, dyi)
+    coefficients__return(n, error)
+    evaluate__entry(n, m, dxo, dyo)
+    evaluate__return(m)
+
+n and m are the sizes of input and output arrays along the axis, and
+dxi, dyi, dxo, and dyo the strides of x, y, x_new, and out in bytes.
+interpolate__call fires when the interpolate function is called, before
+arguments are parsed and inputs converted, and interpolate__entry when
+the kernels start. The time between them is spent converting or copying
+inputs and allocating output.
+For example, count output sizes, where SO is the path of the _akima
+extension module or libakima shared library:
+
+    bpftrace -e 'usdt:SO:akima:evaluate__entry { @[arg1] = count(); }'
+
+:Author: `Christoph Gohlke <https://www.cgohlke.com/>`_
+:License: BSD 3-Clause
+
+Copyright (c) 2007-2025, Christoph Gohlke
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+   contributors may be used to endorse or promote products derived from
+   this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef AKIMA_PROBES_H
+#define AKIMA_PROBES_H
+
+#if !defined(AKIMA_NO_USDT) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define AKIMA_USDT 1
+#endif
+#endif
+
+#if defined(AKIMA_USDT)
+#define AKIMA_PROBE0(name) \
+    DTRACE_PROBE(akima, name)
+#define AKIMA_PROBE1(name, a) \
+    DTRACE_PROBE1(akima, name, a)
+#define AKIMA_PROBE2(name, a, b) \
+    DTRACE_PROBE2(akima, name, a, b)
+#define AKIMA_PROBE3(name, a, b, c) \
+    DTRACE_PROBE3(akima, name, a, b, c)
+#define AKIMA_PROBE4(name, a, b, c, d) \
+    DTRACE_PROBE4(akima, name, a, b, c, d)
+#define AKIMA_PROBE8(name, a, b, c, d, e, f, g, h) \
+    DTRACE_PROBE8(akima, name, a, b, c, d, e, f, g, h)
+#else
+#define AKIMA_PROBE0(name)
+#define AKIMA_PROBE1(name, a)
+#define AKIMA_PROBE2(name, a, b)
+#define AKIMA_PROBE3(name, a, b, c)
+#define AKIMA_PROBE4(name, a, b, c, d)
+#define AKIMA_PROBE8(name, a, b, c, d, e, f, g, h)
+#endif
+
+#endif /* AKIMA_PROBES_H */
@@ -0,0 +1,355 @@
+/* akima_template.h
+
+Akima interpolation kernel, instantiated for one data type.
+
+This file is included by libakima.c once per supported data type with the
+following macros defined:
+
+    AKIMA_XTYPE     C type of input and output x coordinates
+    AKIMA_YTYPE     C type of input and output y coordinates
+    AKIMA_NAME(n)   public name of function n for this data type
+
+Computations are done in double precision regardless of the data types.
+
+Each kernel is written once with runtime strides and force-inlined into a
+public function, which calls it with constant strides if all arrays are
+contiguous. The compiler can then vectorize the loops of the contiguous
+specialization. Strided arrays use the generic version.
+
+The public akima_coefficients and akima_evaluate functions are compiled
+for several CPU targets if AKIMA_TARGET_CLONES is supported.
+
+:Author: `Christoph Gohlke <https://www.cgohlke.com/>`_
+:License: BSD 3-Clause
+
+Copyright (c) 2007-2025, Christoph Gohlke
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+   contributors may be used to endorse or promote products derived from
+   this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#if !defined(AKIMA_XTYPE) || !defined(AKIMA_YTYPE) || !defined(AKIMA_NAME)
+#error "akima_template.h must not be included directly"
+#endif
+
+#define AKIMA_X(ptr) ((double)*((const AKIMA_XTYPE *)(ptr)))
+#define AKIMA_Y(ptr) ((double)*((const AKIMA_YTYPE *)(ptr)))
+#define XI(i) AKIMA_X(xi + (i)*dxi)
+#define YI(i) AKIMA_Y(yi + (i)*dyi)
+#define XO(i) AKIMA_X(xo + (i)*dxo)
+#define YO(i) (*((AKIMA_YTYPE *)(yo + (i)*dyo)))
+
+/*
+The coefficients are computed in three phases: slopes, weights, and
+polynomials. The buffer holds four arrays of size si+1: the constant,
+quadratic, and cubic coefficients, and the slopes at the input points.
+
+The slopes of the intervals, including two extrapolated intervals on each
+side, are stored in the not yet used space of the quadratic and cubic
+coefficients, such that the weighted slopes at the input points can be
+computed from shifted windows without loop-carried dependencies or
+branches.
+*/
+
+/*
+Compute slopes of intervals -2 to si. Return -1 if x coordinates are not
+monotonically increasing.
+*/
+AKIMA_INLINE int
+AKIMA_NAME(akima_slopes_strided)(
+    ptrdiff_t si,                  /* size of input arrays */
+    const char *xi, ptrdiff_t dxi, /* x coordinates and stride */
+    const char *yi, ptrdiff_t dyi, /* y coordinates and stride */
+    double *p  /* buffer for polynomial coefficients of size 4*si+4 */
+    )
+{
+    ptrdiff_t i;
+    int invalid = 0;
+    double x0, x1, x2, x3;       /* extrapolated x values */
+    double y0, y1, y2, y3;       /* extrapolated y values */
+    double t0, t1, t2, t3;       /* temporary values */
+    double d0;
+    double *m;                   /* slopes of intervals -2 to si */
+
+    m = p + si + 3;
+
+    /* slopes of input data */
+    for (i = 0; i < si-1; i++) {
+        d0 = XI(i+1) - XI(i);
+        invalid |= (d0 < 1e-12);
+        m[i] = (YI(i+1) - YI(i)) / d0;
+    }
+    if (invalid)
+        return -1;
+
+    /* extrapolate 2 points on left side */
+    t0 = XI(0);
+    t1 = XI(1);
+    t2 = YI(0);
+    /* t3 = YI(1); */
+
+    x1 = t0 + t1 - XI(2);
+    x0 = x1 + t0 - t1;
+    y1 = (t0 - x1) * (m[1] - 2.0*m[0]) + t2;
+    m[-1] = (t2 - y1) / (t0 - x1);
+    y0 = (x1 - x0) * (m[0] - 2.0*m[-1]) + y1;
+    m[-2] = (y1 - y0) / (x1 - x0);
+
+    /* extrapolate 2 points on right side */
+    t0 = XI(si-2);
+    t1 = XI(si-1);
+    x2 = t1 + t0 - XI(si-3);
+    x3 = x2 + t1 - t0;
+
+    /* t2 = YI(si-2); */
+    t3 = YI(si-1);
+    y2 = (2.0*m[si-2] - m[si-3]) * (x2 - t1) + t3;
+    m[si-1] = (y2 - t3) / (x2 - t1);
+    y3 = (2.0*m[si-1] - m[si-2]) * (x3 - x2) + y2;
+    m[si] = (y3 - y2) / (x3 - x2);
+    return 0;
+}
+
+/*
+Compute slopes at input points, weighted by differences of adjacent
+slopes of intervals. Both results are computed and selected, which
+vectorizes to a blend. The denominator of the weighted result is guarded
+such that equal slopes do not raise FE_INVALID.
+*/
+AKIMA_INLINE void
+AKIMA_NAME(akima_weights)(
+    ptrdiff_t si,                  /* size of input arrays */
+    double *p  /* buffer for polynomial coefficients of size 4*si+4 */
+    )
+{
+    ptrdiff_t i;
+    double t0, t1, t2, t3;
+    double d0, d1, sd, w0, w1;
+    const double *m = p + si + 3;
+    double *p3 = p + si*3 + 3;
+
+    for (i = 0; i < si; i++) {
+        t0 = m[i-2];
+        t1 = m[i-1];
+        t2 = m[i];
+        t3 = m[i+1];
+        d0 = fabs(t3 - t2);
+        d1 = fabs(t1 - t0);
+        sd = d0 + d1;
+        w0 = 0.5 * (t1 + t2);
+        w1 = (d0*t1 + d1*t2) / ((sd < 1e-9) ? 1.0 : sd);
+        p3[i] = (sd < 1e-9) ? w0 : w1;
+    }
+}
+
+/*
+Compute polynomial coefficients of the si-1 intervals from the weighted
+slopes. Overwrites the slopes of intervals.
+*/
+AKIMA_INLINE void
+AKIMA_NAME(akima_polynomials_strided)(
+    ptrdiff_t si,                  /* size of input arrays */
+    const char *xi, ptrdiff_t dxi, /* x coordinates and stride */
+    const char *yi, ptrdiff_t dyi, /* y coordinates and stride */
+    double *p  /* buffer for polynomial coefficients of size 4*si+4 */
+    )
+{
+    ptrdiff_t i;
+    double d0, t1, t2;
+    double *p0, *p1, *p2, *p3;   /* buffer pointers. p3 holds slopes */
+
+    p0 = p;
+    p1 = p + si + 1;
+    p2 = p + si*2 + 2;
+    p3 = p + si*3 + 3;
+
+    for (i = 0; i < si-1; i++) {
+        d0 = XI(i+1) - XI(i);
+        t1 = YI(i);
+        t2 = (YI(i+1) - t1) / d0;
+        p0[i] = t1;
+        p1[i] = (3.0*t2 - 2.0*p3[i] - p3[i+1]) / d0;
+        p2[i] = (p3[i] + p3[i+1] - 2.0*t2) / (d0*d0);
+    }
+}
+
+/*
+Compute polynomial coefficients of Akima sub-spline through input data.
+Return -1 if x coordinates are not monotonically increasing.
+*/
+AKIMA_INLINE int
+AKIMA_NAME(akima_coefficients_strided)(
+    ptrdiff_t si,                  /* size of input arrays */
+    const char *xi, ptrdiff_t dxi, /* x coordinates and stride */
+    const char *yi, ptrdiff_t dyi, /* y coordinates and stride */
+    double *p  /* buffer for polynomial coefficients of size 4*si+4 */
+    )
+{
+    if (AKIMA_NAME(akima_slopes_strided)(si, xi, dxi, yi, dyi, p) != 0) {
+        return -1;
+    }
+    AKIMA_NAME(akima_weights)(si, p);
+    AKIMA_NAME(akima_polynomials_strided)(si, xi, dxi, yi, dyi, p);
+    return 0;
+}
+
+/*
+Evaluate Akima sub-spline, computed by akima_coefficients, at output x
+coordinates, which must be monotonically increasing.
+
+The merge scan finds the run of output points in each interval. The
+polynomial of the interval is then evaluated in Horner form for the
+whole run, which the compiler can vectorize and contract into fused
+multiply-add instructions (see AKIMA_STRICT_FP).
+*/
+AKIMA_INLINE void
+AKIMA_NAME(akima_evaluate_strided)(
+    ptrdiff_t si,                  /* size of input arrays */
+    const char *xi, ptrdiff_t dxi, /* x coordinates and stride */
+    const double *p,               /* polynomial coefficients */
+    ptrdiff_t so,                  /* size of output arrays */
+    const char *xo, ptrdiff_t dxo, /* x coordinates of output and stride */
+    char *yo, ptrdiff_t dyo        /* y output coordinates and stride */
+    )
+{
+    ptrdiff_t i, j, k;
+    double x0, x1, t0, t1;
+    double c0, c1, c2, c3;       /* coefficients of interval */
+    const double *p0, *p1, *p2, *p3;
+
+    p0 = p;
+    p1 = p + si + 1;
+    p2 = p + si*2 + 2;
+    p3 = p + si*3 + 3;
+    si -= 2;
+    i = 0;
+    j = 0;
+    while (j < so) {
+        /* merge scan: advance to interval containing output x */
+        t0 = XO(j);
+        while ((i < si) && (t0 > XI(i+1))) {
+            i++;
+        }
+        /* end of run of output x in interval */
+        k = j + 1;
+        if (i < si) {
+            x1 = XI(i+1);
+            while ((k < so) && !(XO(k) > x1)) {
+                k++;
+            }
+        } else {
+            k = so;
+        }
+        x0 = XI(i);
+        c0 = p0[i];
+        c1 = p3[i];
+        c2 = p1[i];
+        c3 = p2[i];
+        if (k == j + 1) {
+            /* skip vector loop overhead if m is not much larger than n */
+            t1 = t0 - x0;
+            YO(j) = (AKIMA_YTYPE)(c0 + t1*(c1 + t1*(c2 + t1*c3)));
+            j = k;
+            continue;
+        }
+        for (; j < k; j++) {
+            t1 = XO(j) - x0;
+            YO(j) = (AKIMA_YTYPE)(c0 + t1*(c1 + t1*(c2 + t1*c3)));
+        }
+    }
+}
+
+AKIMA_API AKIMA_TARGET_CLONES int
+AKIMA_NAME(akima_coefficients)(
+    ptrdiff_t si,
+    const char *xi, ptrdiff_t dxi,
+    const char *yi, ptrdiff_t dyi,
+    double *p)
+{
+    int error;
+
+    AKIMA_PROBE3(coefficients__entry, si, dxi, dyi);
+    if ((dxi == sizeof(AKIMA_XTYPE)) && (dyi == sizeof(AKIMA_YTYPE))) {
+        error = AKIMA_NAME(akima_coefficients_strided)(
+            si, xi, sizeof(AKIMA_XTYPE), yi, sizeof(AKIMA_YTYPE), p);
+    } else {
+        error = AKIMA_NAME(akima_coefficients_strided)(
+            si, xi, dxi, yi, dyi, p);
+    }
+    AKIMA_PROBE2(coefficients__return, si, error);
+    return error;
+}
+
+AKIMA_API AKIMA_TARGET_CLONES void
+AKIMA_NAME(akima_evaluate)(
+    ptrdiff_t si,
+    const char *xi, ptrdiff_t dxi,
+    const double *p,
+    ptrdiff_t so,
+    const char *xo, ptrdiff_t dxo,
+    char *yo, ptrdiff_t dyo)
+{
+    AKIMA_PROBE4(evaluate__entry, si, so, dxo, dyo);
+    if ((dxi == sizeof(AKIMA_XTYPE)) && (dxo == sizeof(AKIMA_XTYPE)) &&
+            (dyo == sizeof(AKIMA_YTYPE))) {
+        AKIMA_NAME(akima_evaluate_strided)(
+            si, xi, sizeof(AKIMA_XTYPE), p,
+            so, xo, sizeof(AKIMA_XTYPE), yo, sizeof(AKIMA_YTYPE));
+    } else {
+        AKIMA_NAME(akima_evaluate_strided)(
+            si, xi, dxi, p, so, xo, dxo, yo, dyo);
+    }
+    AKIMA_PROBE1(evaluate__return, so);
+}
+
+/*
+Interpolate data using Akima's method.
+Return -1 if x coordinates are not monotonically increasing.
+*/
+AKIMA_API int
+AKIMA_NAME(akima_interpolate)(
+    ptrdiff_t si,                  /* size of input arrays */
+    const char *xi, ptrdiff_t dxi, /* x coordinates and stride */
+    const char *yi, ptrdiff_t dyi, /* y coordinates and stride */
+    ptrdiff_t so,                  /* size of output arrays */
+    const char *xo, ptrdiff_t dxo, /* x coordinates of output and stride */
+    char *yo, ptrdiff_t dyo,       /* y output coordinates and stride */
+    double *p  /* buffer for polynomial coefficients of size 4*si+4 */
+    )
+{
+    if (AKIMA_NAME(akima_coefficients)(si, xi, dxi, yi, dyi, p) != 0) {
+        return -1;
+    }
+    AKIMA_NAME(akima_evaluate)(si, xi, dxi, p, so, xo, dxo, yo, dyo);
+    return 0;
+}
+
+#undef AKIMA_X
+#undef AKIMA_Y
+#undef XI
+#undef YI
+#undef XO
+#undef YO
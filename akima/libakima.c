@@ -0,0 +1,211 @@
+/* libakima.c
+
+Akima interpolation library.
+
+Implementation of Akima's interpolation method without dependency on
+Python. Used by the akima._akima Python extension module and built as
+the libakima library by CMake.
+
+:Author: `Christoph Gohlke <https://www.cgohlke.com/>`_
+:License: BSD 3-Clause
+
+Copyright (c) 2007-2025, Christoph Gohlke
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+   contributors may be used to endorse or promote products derived from
+   this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "akima.h"
+#include "akima_probes.h"
+
+
+/*
+A new method of interpolation and smooth curve fitting based on local
+procedures. Hiroshi Akima, J. ACM, October 1970, 17(4), 589-602.
+*/
+
+/* force inline kernels into their contiguous and strided callers */
+#if defined(_MSC_VER)
+#define AKIMA_INLINE static __forceinline
+#elif defined(__GNUC__)
+#define AKIMA_INLINE static inline __attribute__((always_inline))
+#else
+#define AKIMA_INLINE static inline
+#endif
+
+/*
+Compile the public kernels for x86-64 micro-architecture levels v4
+(AVX-512), v3 (AVX2, FMA), and baseline. The dynamic loader selects the
+best version for the CPU (GCC function multiversioning using ifunc).
+Define AKIMA_NO_CPU_DISPATCH to build baseline code only.
+*/
+#if !defined(AKIMA_NO_CPU_DISPATCH) && defined(__GNUC__) && \
+    !defined(__clang__) && (__GNUC__ >= 12) && defined(__x86_64__) && \
+    defined(__linux__)
+#define AKIMA_CPU_DISPATCH 1
+#define AKIMA_TARGET_CLONES \
+    __attribute__((target_clones( \
+        "arch=x86-64-v4", "arch=x86-64-v3", "default")))
+#else
+#define AKIMA_TARGET_CLONES
+#endif
+
+/*
+Floating point mode of the kernels. By default, the compiler may contract
+multiplications and additions into fused multiply-add instructions on
+CPU targets supporting FMA. This is faster and rounds once per operation
+pair, but results can differ in the last bit between CPU targets.
+Define AKIMA_STRICT_FP to round every operation separately and get the
+same results on all targets.
+*/
+#if defined(AKIMA_STRICT_FP)
+#if defined(_MSC_VER) && !defined(__clang__)
+#pragma fp_contract(off)
+#elif defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+#define AKIMA_FP_MODE "strict"
+#else
+#define AKIMA_FP_MODE "fma"
+#endif
+
+/* float64 kernel: akima_coefficients, akima_evaluate, akima_interpolate */
+#define AKIMA_XTYPE double
+#define AKIMA_YTYPE double
+#define AKIMA_NAME(name) name
+#include "akima_template.h"
+#undef AKIMA_XTYPE
+#undef AKIMA_YTYPE
+#undef AKIMA_NAME
+
+/* float32 kernel: akima_coefficients_f, akima_evaluate_f, ... */
+#define AKIMA_XTYPE float
+#define AKIMA_YTYPE float
+#define AKIMA_NAME(name) name##_f
+#include "akima_template.h"
+#undef AKIMA_XTYPE
+#undef AKIMA_YTYPE
+#undef AKIMA_NAME
+
+/*
+Return name of CPU target selected for the kernels: "x86-64-v4",
+"x86-64-v3", "x86-64", or "baseline" if not compiled with CPU dispatch.
+*/
+AKIMA_API const char *
+akima_cpu_target(void)
+{
+#if defined(AKIMA_CPU_DISPATCH)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("x86-64-v4")) {
+        return "x86-64-v4";
+    }
+    if (__builtin_cpu_supports("x86-64-v3")) {
+        return "x86-64-v3";
+    }
+    return "x86-64";
+#else
+    return "baseline";
+#endif
+}
+
+/*
+Return floating point mode of the kernels: "fma" if the compiler may
+contract operations into fused multiply-add instructions or "strict" if
+built with AKIMA_STRICT_FP.
+*/
+AKIMA_API const char *
+akima_fp_mode(void)
+{
+    return AKIMA_FP_MODE;
+}
+
+/*
+Akima sub-spline owning a copy of the input x coordinates and the
+polynomial coefficients. Does not require the GIL.
+*/
+struct akima_spline {
+    ptrdiff_t size;
+    double *x;
+    double *p;
+};
+
+/*
+Return new spline through input data or NULL if the size is too small,
+x coordinates are not monotonically increasing, or out of memory.
+*/
+AKIMA_API akima_spline *
+akima_spline_create(
+    ptrdiff_t si,
+    const char *xi, ptrdiff_t dxi,
+    const char *yi, ptrdiff_t dyi)
+{
+    akima_spline *spline;
+    ptrdiff_t i;
+
+    if (si < 3) {
+        return NULL;
+    }
+    spline = (akima_spline *)malloc(
+        sizeof(akima_spline) + (si * 5 + 4) * sizeof(double));
+    if (spline == NULL) {
+        return NULL;
+    }
+    spline->size = si;
+    spline->x = (double *)(spline + 1);
+    spline->p = spline->x + si;
+    for (i = 0; i < si; i++) {
+        spline->x[i] = *((const double *)(xi + i * dxi));
+    }
+    if (akima_coefficients(si, xi, dxi, yi, dyi, spline->p) != 0) {
+        free(spline);
+        return NULL;
+    }
+    return spline;
+}
+
+/* Evaluate spline at output x coordinates */
+AKIMA_API void
+akima_spline_evaluate(
+    const akima_spline *spline,
+    ptrdiff_t so,
+    const char *xo, ptrdiff_t dxo,
+    char *yo, ptrdiff_t dyo)
+{
+    akima_evaluate(
+        spline->size, (const char *)spline->x, sizeof(double), spline->p,
+        so, xo, dxo, yo, dyo);
+}
+
+AKIMA_API void
+akima_spline_destroy(akima_spline *spline)
+{
+    free(spline);
+}
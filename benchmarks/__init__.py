@@ -0,0 +1 @@
+# akima/benchmarks/__init__.py
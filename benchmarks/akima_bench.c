@@ -0,0 +1,539 @@
+/* akima_bench.c
+
+Micro-benchmark of the libakima kernels without Python.
+
+Times the phases of Akima interpolation of synthetic data, calling the
+kernels directly:
+
+    slopes        slopes of intervals, including extrapolated intervals
+    weights       weighted slopes at input points
+    polynomials   polynomial coefficients of intervals
+    evaluate      evaluation of polynomials at output points
+
+The kernels are compiled into this executable from libakima.c, such that
+the phases, which are internal to the library, can be timed separately.
+They are built for the same CPU targets as the library.
+
+Usage:
+
+    akima_bench [-n size] [-m outsize] [-r repeat] [-c cpu] [-f] [-s] [-p]
+                [-j]
+
+    -n    number of input points (default 100000)
+    -m    number of output points (default 10 * n)
+    -r    number of repetitions; the fastest is reported (default 20)
+    -c    CPU to pin the process to (Linux only; default no pinning)
+    -f    use float32 kernels instead of float64
+    -s    use strided arrays (stride of 2 elements)
+    -p    count hardware events (Linux perf_event_open)
+    -j    print JSON instead of a table
+
+Cycles are time stamp counter ticks on x86 and nanoseconds elsewhere.
+They are reported per input point for the coefficient phases and per
+output point for the evaluation.
+
+Hardware event counts are summed over all repetitions of a phase and
+reported per point: CPU cycles, instructions per cycle, last level cache
+misses, and branch mispredictions. They include user space only. If the
+counters can not be opened, for example because of perf_event_paranoid
+or in virtual machines, only timings are reported. Counts are scaled if
+the counters were multiplexed with other perf users. Runs during which
+the counters were not scheduled are not counted.
+
+Build with CMake option AKIMA_BUILD_BENCHMARKS:
+
+    cmake -S . -B build -DAKIMA_BUILD_BENCHMARKS=ON
+    cmake --build build --target akima_bench
+
+:Author: `Christoph Gohlke <https://www.cgohlke.com/>`_
+:License: BSD 3-Clause
+
+Copyright (c) 2007-2025, Christoph Gohlke
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+   contributors may be used to endorse or promote products derived from
+   this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define BENCH_PERF 1
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define BENCH_TSC 1
+#endif
+
+#include "libakima.c"
+
+/*
+Phases of the float64 and float32 kernels, compiled for the same CPU
+targets as the public functions.
+*/
+#define BENCH_PHASES(suffix, xtype) \
+static AKIMA_TARGET_CLONES int \
+bench_slopes##suffix( \
+    ptrdiff_t si, const char *xi, ptrdiff_t dxi, \
+    const char *yi, ptrdiff_t dyi, double *p) \
+{ \
+    if ((dxi == sizeof(xtype)) && (dyi == sizeof(xtype))) { \
+        return akima_slopes_strided##suffix( \
+            si, xi, sizeof(xtype), yi, sizeof(xtype), p); \
+    } \
+    return akima_slopes_strided##suffix(si, xi, dxi, yi, dyi, p); \
+} \
+\
+static AKIMA_TARGET_CLONES void \
+bench_weights##suffix(ptrdiff_t si, double *p) \
+{ \
+    akima_weights##suffix(si, p); \
+} \
+\
+static AKIMA_TARGET_CLONES void \
+bench_polynomials##suffix( \
+    ptrdiff_t si, const char *xi, ptrdiff_t dxi, \
+    const char *yi, ptrdiff_t dyi, double *p) \
+{ \
+    if ((dxi == sizeof(xtype)) && (dyi == sizeof(xtype))) { \
+        akima_polynomials_strided##suffix( \
+            si, xi, sizeof(xtype), yi, sizeof(xtype), p); \
+        return; \
+    } \
+    akima_polynomials_strided##suffix(si, xi, dxi, yi, dyi, p); \
+}
+
+BENCH_PHASES(, double)
+BENCH_PHASES(_f, float)
+
+/* Hardware events counted with perf_event_open */
+enum {COUNTER_CYCLES, COUNTER_INSTRUCTIONS, COUNTER_CACHE_MISSES,
+      COUNTER_BRANCH_MISSES, COUNTER_COUNT};
+
+typedef struct {
+    const char *name;
+    ptrdiff_t points;       /* number of points phase is normalized to */
+    double ticks;           /* fastest run */
+    double ns;              /* fastest run */
+    double counts[COUNTER_COUNT];  /* events summed over all runs */
+    int runs;
+} phase_t;
+
+/* File descriptors of event group. The first is the group leader */
+typedef struct {
+    int fd[COUNTER_COUNT];
+    int enabled;
+} counters_t;
+
+/*
+Open hardware event counters of the calling thread.
+Return 0 or -1 if counters are not available.
+*/
+static int
+counters_open(counters_t *counters)
+{
+#if defined(BENCH_PERF)
+    static const unsigned long long config[COUNTER_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES
+    };
+    struct perf_event_attr attr;
+    int i, j;
+
+    counters->enabled = 0;
+    for (i = 0; i < COUNTER_COUNT; i++) {
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = config[i];
+        attr.disabled = (i == 0);
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP |
+                           PERF_FORMAT_TOTAL_TIME_ENABLED |
+                           PERF_FORMAT_TOTAL_TIME_RUNNING;
+        counters->fd[i] = (int)syscall(
+            __NR_perf_event_open, &attr, 0, -1,
+            (i == 0) ? -1 : counters->fd[0], 0);
+        if (counters->fd[i] < 0) {
+            for (j = 0; j < i; j++) {
+                close(counters->fd[j]);
+            }
+            return -1;
+        }
+    }
+    counters->enabled = 1;
+    return 0;
+#else
+    counters->enabled = 0;
+    return -1;
+#endif
+}
+
+static void
+counters_close(counters_t *counters)
+{
+#if defined(BENCH_PERF)
+    int i;
+    if (counters->enabled) {
+        for (i = 0; i < COUNTER_COUNT; i++) {
+            close(counters->fd[i]);
+        }
+        counters->enabled = 0;
+    }
+#endif
+}
+
+static void
+counters_start(counters_t *counters)
+{
+#if defined(BENCH_PERF)
+    if (counters->enabled) {
+        ioctl(counters->fd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(counters->fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+}
+
+/*
+Stop counters and add event counts to phase. Counts are scaled by the
+ratio of enabled to running time if the group was multiplexed. Runs
+during which the group was not scheduled are skipped.
+*/
+static void
+counters_stop(counters_t *counters, phase_t *phase)
+{
+#if defined(BENCH_PERF)
+    /* number of events, time enabled, time running, and event counts */
+    unsigned long long values[COUNTER_COUNT + 3];
+    double scale;
+    int i;
+
+    if (counters->enabled) {
+        ioctl(counters->fd[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        if ((read(counters->fd[0], values, sizeof(values)) ==
+                (ssize_t)sizeof(values)) && (values[0] == COUNTER_COUNT) &&
+                (values[2] > 0)) {
+            scale = (double)values[1] / (double)values[2];
+            for (i = 0; i < COUNTER_COUNT; i++) {
+                phase->counts[i] += (double)values[i + 3] * scale;
+            }
+            phase->runs++;
+        }
+    }
+#else
+    (void)counters;
+    (void)phase;
+#endif
+}
+
+enum {PHASE_SLOPES, PHASE_WEIGHTS, PHASE_POLYNOMIALS, PHASE_EVALUATE,
+      PHASE_COUNT};
+
+static double
+clock_ns(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static unsigned long long
+clock_ticks(void)
+{
+#if defined(BENCH_TSC)
+    return (unsigned long long)__rdtsc();
+#else
+    return (unsigned long long)clock_ns();
+#endif
+}
+
+/* Start timing phase */
+#define BENCH_START \
+    counters_start(&counters); \
+    t0 = clock_ns(); \
+    c0 = clock_ticks();
+
+/* Stop timing phase and keep fastest run */
+#define BENCH_STOP(phase) \
+    c1 = clock_ticks(); \
+    t1 = clock_ns(); \
+    if ((double)(c1 - c0) < phases[phase].ticks) { \
+        phases[phase].ticks = (double)(c1 - c0); \
+    } \
+    if ((t1 - t0) < phases[phase].ns) { \
+        phases[phase].ns = t1 - t0; \
+    } \
+    counters_stop(&counters, &phases[phase]);
+
+/* Fill arrays with noisy data of monotonically increasing x */
+static void
+synthetic_data(
+    ptrdiff_t si, char *xi, char *yi, ptrdiff_t so, char *xo,
+    ptrdiff_t stride, int single)
+{
+    ptrdiff_t i;
+    unsigned long long seed = 42;
+    double x = 0.0, r;
+
+    for (i = 0; i < si; i++) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        r = (double)(seed >> 11) / 9007199254740992.0;
+        x += 0.1 + r;
+        if (single) {
+            *(float *)(xi + i * stride) = (float)x;
+            *(float *)(yi + i * stride) = (float)(r - 0.5);
+        } else {
+            *(double *)(xi + i * stride) = x;
+            *(double *)(yi + i * stride) = r - 0.5;
+        }
+    }
+    for (i = 0; i < so; i++) {
+        r = x * (double)i / (double)(so > 1 ? so - 1 : 1);
+        if (single) {
+            *(float *)(xo + i * stride) = (float)r;
+        } else {
+            *(double *)(xo + i * stride) = r;
+        }
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+    ptrdiff_t si = 100000, so = -1, stride, itemsize;
+    int i, repeat = 20, cpu = -1, single = 0, strided = 0, json = 0;
+    int perf = 0;
+    counters_t counters;
+    char *xi, *yi, *xo, *yo;
+    double *p;
+    double t0, t1;
+    unsigned long long c0, c1;
+    phase_t phases[PHASE_COUNT] = {
+        {"slopes", 0, 1e300, 1e300, {0}, 0},
+        {"weights", 0, 1e300, 1e300, {0}, 0},
+        {"polynomials", 0, 1e300, 1e300, {0}, 0},
+        {"evaluate", 0, 1e300, 1e300, {0}, 0}
+    };
+
+    for (i = 1; i < argc; i++) {
+        if ((strcmp(argv[i], "-n") == 0) && (i + 1 < argc)) {
+            si = (ptrdiff_t)atoll(argv[++i]);
+        } else if ((strcmp(argv[i], "-m") == 0) && (i + 1 < argc)) {
+            so = (ptrdiff_t)atoll(argv[++i]);
+        } else if ((strcmp(argv[i], "-r") == 0) && (i + 1 < argc)) {
+            repeat = atoi(argv[++i]);
+        } else if ((strcmp(argv[i], "-c") == 0) && (i + 1 < argc)) {
+            cpu = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-f") == 0) {
+            single = 1;
+        } else if (strcmp(argv[i], "-s") == 0) {
+            strided = 1;
+        } else if (strcmp(argv[i], "-p") == 0) {
+            perf = 1;
+        } else if (strcmp(argv[i], "-j") == 0) {
+            json = 1;
+        } else {
+            fprintf(stderr,
+                "usage: %s [-n size] [-m outsize] [-r repeat] [-c cpu] "
+                "[-f] [-s] [-p] [-j]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (so < 0) {
+        so = si * 10;
+    }
+    if ((si < 3) || (so < 1) || (repeat < 1)) {
+        fprintf(stderr, "invalid arguments\n");
+        return 2;
+    }
+
+    if (cpu >= 0) {
+#if defined(__linux__)
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+        if (sched_setaffinity(0, sizeof(cpu_set_t), &cpus) != 0) {
+            fprintf(stderr, "failed to pin to CPU %i\n", cpu);
+            return 1;
+        }
+#else
+        fprintf(stderr, "pinning to CPU is not supported\n");
+#endif
+    }
+
+    itemsize = single ? sizeof(float) : sizeof(double);
+    stride = itemsize * (strided ? 2 : 1);
+    xi = (char *)malloc(si * stride);
+    yi = (char *)malloc(si * stride);
+    xo = (char *)malloc(so * stride);
+    yo = (char *)malloc(so * stride);
+    p = (double *)malloc(AKIMA_BUFFER_SIZE(si) * sizeof(double));
+    if ((xi == NULL) || (yi == NULL) || (xo == NULL) || (yo == NULL) ||
+            (p == NULL)) {
+        fprintf(stderr, "failed to allocate arrays\n");
+        return 1;
+    }
+    synthetic_data(si, xi, yi, so, xo, stride, single);
+
+    counters.enabled = 0;
+    if (perf && (counters_open(&counters) != 0)) {
+        fprintf(stderr,
+            "hardware event counters not available, timing only\n");
+    }
+
+    phases[PHASE_SLOPES].points = si;
+    phases[PHASE_WEIGHTS].points = si;
+    phases[PHASE_POLYNOMIALS].points = si;
+    phases[PHASE_EVALUATE].points = so;
+
+    /* each phase uses the results of the previous phase */
+    for (i = 0; i < repeat; i++) {
+        BENCH_START;
+        if ((single ? bench_slopes_f : bench_slopes)(
+                si, xi, stride, yi, stride, p) != 0) {
+            fprintf(stderr, "x is not monotonically increasing\n");
+            return 1;
+        }
+        BENCH_STOP(PHASE_SLOPES);
+    }
+    for (i = 0; i < repeat; i++) {
+        BENCH_START;
+        (single ? bench_weights_f : bench_weights)(si, p);
+        BENCH_STOP(PHASE_WEIGHTS);
+    }
+    for (i = 0; i < repeat; i++) {
+        BENCH_START;
+        (single ? bench_polynomials_f : bench_polynomials)(
+            si, xi, stride, yi, stride, p);
+        BENCH_STOP(PHASE_POLYNOMIALS);
+    }
+    for (i = 0; i < repeat; i++) {
+        BENCH_START;
+        (single ? akima_evaluate_f : akima_evaluate)(
+            si, xi, stride, p, so, xo, stride, yo, stride);
+        BENCH_STOP(PHASE_EVALUATE);
+    }
+
+    if (json) {
+        printf("{\n");
+        printf("  \"version\": \"%s\",\n", AKIMA_VERSION);
+        printf("  \"cpu_target\": \"%s\",\n", akima_cpu_target());
+        printf("  \"fp_mode\": \"%s\",\n", akima_fp_mode());
+        printf("  \"dtype\": \"%s\",\n", single ? "float32" : "float64");
+        printf("  \"strided\": %s,\n", strided ? "true" : "false");
+        printf("  \"n\": %lld,\n", (long long)si);
+        printf("  \"m\": %lld,\n", (long long)so);
+        printf("  \"repeat\": %i,\n", repeat);
+        printf("  \"cpu\": %i,\n", cpu);
+        printf("  \"counters\": %s,\n",
+               counters.enabled ? "true" : "false");
+        printf("  \"phases\": {\n");
+        for (i = 0; i < PHASE_COUNT; i++) {
+            const phase_t *phase = &phases[i];
+            double points = (double)phase->points;
+            printf("    \"%s\": {\"points\": %lld, \"cycles_per_point\": "
+                   "%.4f, \"ns_per_point\": %.4f",
+                   phase->name, (long long)phase->points,
+                   phase->ticks / points, phase->ns / points);
+            if (phase->runs > 0) {
+                points *= (double)phase->runs;
+                printf(", \"core_cycles_per_point\": %.4f, "
+                       "\"instructions_per_cycle\": ",
+                       phase->counts[COUNTER_CYCLES] / points);
+                if (phase->counts[COUNTER_CYCLES] > 0.0) {
+                    printf("%.4f", phase->counts[COUNTER_INSTRUCTIONS] /
+                                       phase->counts[COUNTER_CYCLES]);
+                } else {
+                    printf("null");
+                }
+                printf(", \"cache_misses_per_point\": %.6f, "
+                       "\"branch_misses_per_point\": %.6f",
+                       phase->counts[COUNTER_CACHE_MISSES] / points,
+                       phase->counts[COUNTER_BRANCH_MISSES] / points);
+            }
+            printf("}%s\n", (i + 1 < PHASE_COUNT) ? "," : "");
+        }
+        printf("  }\n}\n");
+    } else {
+        printf("akima %s, CPU target %s, FP mode %s, %s%s, n=%lld, "
+               "m=%lld\n", AKIMA_VERSION, akima_cpu_target(),
+               akima_fp_mode(), single ? "float32" : "float64",
+               strided ? " strided" : "", (long long)si, (long long)so);
+        printf("%-12s %12s %12s", "phase", "cycles/point", "ns/point");
+        if (counters.enabled) {
+            printf(" %12s %8s %12s %12s", "core cycles", "IPC",
+                   "cache miss", "branch miss");
+        }
+        printf("\n");
+        for (i = 0; i < PHASE_COUNT; i++) {
+            const phase_t *phase = &phases[i];
+            double points = (double)phase->points;
+            printf("%-12s %12.3f %12.3f", phase->name,
+                   phase->ticks / points, phase->ns / points);
+            if (phase->runs > 0) {
+                points *= (double)phase->runs;
+                printf(" %12.3f", phase->counts[COUNTER_CYCLES] / points);
+                if (phase->counts[COUNTER_CYCLES] > 0.0) {
+                    printf(" %8.3f", phase->counts[COUNTER_INSTRUCTIONS] /
+                                         phase->counts[COUNTER_CYCLES]);
+                } else {
+                    printf(" %8s", "-");
+                }
+                printf(" %12.5f %12.5f",
+                       phase->counts[COUNTER_CACHE_MISSES] / points,
+                       phase->counts[COUNTER_BRANCH_MISSES] / points);
+            }
+            printf("\n");
+        }
+    }
+
+    counters_close(&counters);
+    free(xi);
+    free(yi);
+    free(xo);
+    free(yo);
+    free(p);
+    return 0;
+}
@@ -0,0 +1,181 @@
+# akima/benchmarks/bench_interpolate.py
+
+"""Benchmarks of the akima package.
+
+The benchmark classes are compatible with `airspeed velocity
+<https://asv.readthedocs.io>`_::
+
+    python -m asv run
+
+Run this file to print a table of all benchmarks, reporting the time per
+call, per output point, and the throughput of input and output arrays::
+
+    python benchmarks/bench_interpolate.py [filter]
+
+Only benchmarks whose name contains `filter` are run.
+
+Implementations:
+
+- ``c``: ``akima.interpolate`` (C extension).
+- ``gufunc``: ``akima.interpolate_gufunc`` (native float32 and float64).
+- ``py``: ``akima.interpolate_py`` (pure Python and NumPy).
+- ``scipy``: ``scipy.interpolate.Akima1DInterpolator``.
+
+The C implementations require monotonically increasing `x_new`.
+Unsorted queries are sorted, interpolated, and scattered back, which is
+included in the timing.
+
+"""
+
+from __future__ import annotations
+
+import itertools
+import sys
+import timeit
+
+import numpy
+
+try:
+    import akima
+except ImportError:
+    import os
+
+    sys.path.insert(0, os.path.dirname(os.path.dirname(__file__)))
+    import akima
+
+try:
+    from scipy.interpolate import Akima1DInterpolator
+except ImportError:
+    Akima1DInterpolator = None
+
+
+class Interpolate:
+    """Interpolate 1D data of size n at m points with one implementation."""
+
+    params = (
+        ['c', 'gufunc', 'py', 'scipy'],
+        [10, 1000, 100000],
+        [0.5, 1, 100],
+        [True, False],
+    )
+    param_names = ['impl', 'n', 'upsample', 'sorted']
+
+    def setup(self, impl, n, upsample, sorted):
+        if impl == 'scipy' and Akima1DInterpolator is None:
+            raise NotImplementedError('scipy not available')
+        if impl == 'py' and n * upsample > 10**6:
+            raise NotImplementedError('too slow')
+        rng = numpy.random.default_rng(42)
+        m = max(int(n * upsample), 1)
+        self.x = numpy.cumsum(rng.uniform(0.1, 1.0, n))
+        self.y = rng.normal(size=n)
+        self.x_new = rng.uniform(self.x[0], self.x[-1], m)
+        if sorted:
+            self.x_new.sort()
+        self.func = _implementation(impl, sorted)
+        self.npoints = m
+        self.nbytes = (2 * n + 2 * m) * 8
+
+    def time_interpolate(self, impl, n, upsample, sorted):
+        self.func(self.x, self.y, self.x_new)
+
+
+class InterpolateLanes:
+    """Interpolate lanes of 2D data along contiguous or strided axis."""
+
+    params = (
+        ['c', 'gufunc'],
+        ['float64', 'float32'],
+        [1, 64, 1024],
+        ['contiguous', 'strided'],
+        [1, 0],
+    )
+    param_names = ['impl', 'dtype', 'lanes', 'axis', 'maxworkers']
+
+    def setup(self, impl, dtype, lanes, axis, maxworkers):
+        if impl == 'gufunc' and maxworkers != 1:
+            raise NotImplementedError('gufunc is not threaded')
+        n = 1000
+        m = 10000
+        rng = numpy.random.default_rng(42)
+        self.x = numpy.cumsum(rng.uniform(0.1, 1.0, n)).astype(dtype)
+        self.x_new = numpy.linspace(self.x[0], self.x[-1], m, dtype=dtype)
+        y = rng.normal(size=(lanes, n)).astype(dtype)
+        if axis == 'strided':
+            y = numpy.ascontiguousarray(y.T)
+        self.y = y
+        self.axis = -1 if axis == 'contiguous' else 0
+        self.impl = impl
+        self.maxworkers = maxworkers
+        self.npoints = lanes * m
+        self.nbytes = (lanes * (n + m) + n + m) * numpy.dtype(dtype).itemsize
+
+    def time_interpolate(self, impl, dtype, lanes, axis, maxworkers):
+        if self.impl == 'gufunc':
+            akima.interpolate_gufunc(
+                self.x, self.y, self.x_new, axes=[0, self.axis, 0, self.axis]
+            )
+        else:
+            akima.interpolate(
+                self.x,
+                self.y,
+                self.x_new,
+                axis=self.axis,
+                maxworkers=self.maxworkers,
+            )
+
+
+def _implementation(impl, sorted):
+    """Return function interpolating x, y at x_new using implementation."""
+    if impl == 'c':
+        func = akima.interpolate
+    elif impl == 'gufunc':
+        func = akima.interpolate_gufunc
+    elif impl == 'py':
+        func = akima.interpolate_py
+    elif impl == 'scipy':
+        return lambda x, y, x_new: Akima1DInterpolator(x, y)(x_new)
+    else:
+        raise ValueError(f'unknown implementation {impl!r}')
+    if sorted:
+        return func
+
+    def unsorted(x, y, x_new):
+        index = numpy.argsort(x_new)
+        out = numpy.empty_like(x_new)
+        out[index] = func(x, y, x_new[index])
+        return out
+
+    return unsorted
+
+
+def main(argv=None):
+    """Run all benchmarks and print time per output point and throughput."""
+    if argv is None:
+        argv = sys.argv
+    pattern = argv[1] if len(argv) > 1 else ''
+    akima.show_config()
+    print()
+    print(f'{"benchmark":<56} {"us/call":>10} {"ns/point":>9} {"GB/s":>7}')
+    for cls in (Interpolate, InterpolateLanes):
+        for params in itertools.product(*cls.params):
+            name = cls.__name__ + '(' + ', '.join(map(str, params)) + ')'
+            if pattern not in name:
+                continue
+            bench = cls()
+            try:
+                bench.setup(*params)
+            except NotImplementedError:
+                continue
+            timer = timeit.Timer(lambda: bench.time_interpolate(*params))
+            number, _ = timer.autorange()
+            seconds = min(timer.repeat(repeat=5, number=number)) / number
+            print(
+                f'{name:<56} {seconds * 1e6:>10.2f} '
+                f'{seconds * 1e9 / bench.npoints:>9.2f} '
+                f'{bench.nbytes / seconds * 1e-9:>7.2f}'
+            )
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,791 @@
+/* akima_fuzz.c
+
+Differential fuzzer of the libakima kernels.
+
+Decodes adversarial input data, strides, and output coordinates from the
+fuzz input and compares all kernel variants against a scalar reference
+implementation of Akima's method:
+
+    public functions (CPU dispatch), contiguous and strided
+    each CPU target clone supported by the CPU (x86-64-v4, v3, baseline)
+    akima_coefficients and akima_evaluate in chunks of output points
+    akima_interpolate and akima_spline API
+    float32 kernels, compared to the reference of the rounded inputs
+
+Results must not differ from the reference by more than FUZZ_ULPS units
+in the last place of the magnitudes of the terms contributing to the
+result. Rounding errors of operations that compilers may contract into
+fused multiply-add (see AKIMA_STRICT_FP) are propagated through the
+reference with first-order bounds. The bounds are loose where the method
+is ill-conditioned, for example for weighted slopes close to the 1e-9
+threshold. Inputs with x coordinates that are not monotonically
+increasing must be rejected by all variants. Failures are reported to
+stderr and abort the process.
+
+The kernels are compiled into this executable from libakima.c, such that
+the CPU target clones, which are internal to the library, can be called.
+
+Build with CMake option AKIMA_BUILD_FUZZERS. With Clang, the fuzzer is
+linked with libFuzzer and sanitizers:
+
+    CC=clang cmake -S . -B build -DAKIMA_BUILD_FUZZERS=ON
+    cmake --build build --target akima_fuzz
+    build/akima_fuzz -max_total_time=600 corpus
+
+Other compilers build a standalone driver, which runs offline with
+deterministic pseudo-random inputs or replays input files:
+
+    akima_fuzz [-r runs] [-s seed] [file ...]
+
+    -r    number of random inputs (default 100000)
+    -s    seed of pseudo-random inputs (default 1)
+
+ctest runs the fuzzer with 2000 inputs:
+
+    ctest --test-dir build --output-on-failure
+
+:Author: `Christoph Gohlke <https://www.cgohlke.com/>`_
+:License: BSD 3-Clause
+
+Copyright (c) 2007-2025, Christoph Gohlke
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+   contributors may be used to endorse or promote products derived from
+   this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <float.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libakima.c"
+
+/* tolerance in units of the last place of magnitudes of terms */
+#define FUZZ_ULPS 16.0
+
+#define FUZZ_MAXN 512
+#define FUZZ_MAXM 1024
+
+/* threshold of sum of slope differences in akima_weights */
+#define FUZZ_WEIGHTS_THRESHOLD 1e-9
+
+/* threshold of x differences in akima_slopes_strided */
+#define FUZZ_X_THRESHOLD 1e-12
+
+typedef int (*coefficients_t)(
+    ptrdiff_t, const char *, ptrdiff_t, const char *, ptrdiff_t, double *);
+
+typedef void (*evaluate_t)(
+    ptrdiff_t, const char *, ptrdiff_t, const double *,
+    ptrdiff_t, const char *, ptrdiff_t, char *, ptrdiff_t);
+
+/*
+CPU target clones of the public kernels. The clones are local symbols
+named by GCC function multiversioning.
+*/
+#if defined(AKIMA_CPU_DISPATCH)
+#define FUZZ_CLONES(target) \
+extern int coefficients_##target( \
+    ptrdiff_t, const char *, ptrdiff_t, const char *, ptrdiff_t, double *) \
+    __asm__("akima_coefficients." #target); \
+extern void evaluate_##target( \
+    ptrdiff_t, const char *, ptrdiff_t, const double *, \
+    ptrdiff_t, const char *, ptrdiff_t, char *, ptrdiff_t) \
+    __asm__("akima_evaluate." #target); \
+extern int coefficients_f_##target( \
+    ptrdiff_t, const char *, ptrdiff_t, const char *, ptrdiff_t, double *) \
+    __asm__("akima_coefficients_f." #target); \
+extern void evaluate_f_##target( \
+    ptrdiff_t, const char *, ptrdiff_t, const double *, \
+    ptrdiff_t, const char *, ptrdiff_t, char *, ptrdiff_t) \
+    __asm__("akima_evaluate_f." #target);
+
+FUZZ_CLONES(arch_x86_64_v4)
+FUZZ_CLONES(arch_x86_64_v3)
+FUZZ_CLONES(default)
+#endif
+
+typedef struct variant_t {
+    const char *name;
+    coefficients_t coefficients;
+    evaluate_t evaluate;
+    coefficients_t coefficients_f;
+    evaluate_t evaluate_f;
+    int supported;
+} variant_t;
+
+static variant_t variants[] = {
+    {"dispatch", akima_coefficients, akima_evaluate,
+     akima_coefficients_f, akima_evaluate_f, 1},
+#if defined(AKIMA_CPU_DISPATCH)
+    {"x86-64-v4", coefficients_arch_x86_64_v4, evaluate_arch_x86_64_v4,
+     coefficients_f_arch_x86_64_v4, evaluate_f_arch_x86_64_v4, 0},
+    {"x86-64-v3", coefficients_arch_x86_64_v3, evaluate_arch_x86_64_v3,
+     coefficients_f_arch_x86_64_v3, evaluate_f_arch_x86_64_v3, 0},
+    {"x86-64", coefficients_default, evaluate_default,
+     coefficients_f_default, evaluate_f_default, 1},
+#endif
+};
+
+#define FUZZ_NVARIANTS ((int)(sizeof(variants) / sizeof(variants[0])))
+
+static void
+init_variants(void)
+{
+#if defined(AKIMA_CPU_DISPATCH)
+    __builtin_cpu_init();
+    variants[1].supported = __builtin_cpu_supports("x86-64-v4");
+    variants[2].supported = __builtin_cpu_supports("x86-64-v3");
+#endif
+}
+
+/* Problem decoded from fuzz input */
+typedef struct problem_t {
+    ptrdiff_t n;                 /* size of input arrays */
+    ptrdiff_t m;                 /* size of output arrays */
+    ptrdiff_t split;             /* output index to split evaluation at */
+    int single;                  /* use float32 kernels */
+    int strides[4];              /* strides of x, y, x_new, out in items */
+    double x[FUZZ_MAXN];
+    double y[FUZZ_MAXN];
+    double xo[FUZZ_MAXM];
+} problem_t;
+
+/* Reference results of problem */
+typedef struct reference_t {
+    int error;                   /* -1 if x is not valid */
+    double yo[FUZZ_MAXM];        /* interpolated values */
+    double tol[FUZZ_MAXM];       /* tolerance of values or NaN to skip */
+} reference_t;
+
+/*
+Stream of fuzz input bytes, continued with pseudo-random bytes such that
+short inputs decode to valid problems.
+*/
+typedef struct stream_t {
+    const uint8_t *data;
+    size_t size;
+    uint32_t state;
+} stream_t;
+
+static uint8_t
+take_u8(stream_t *s)
+{
+    uint8_t value;
+    if (s->size > 0) {
+        value = s->data[0];
+        s->data++;
+        s->size--;
+        s->state = s->state * 31 + value;
+        return value;
+    }
+    s->state = s->state * 1664525 + 1013904223;
+    return (uint8_t)(s->state >> 24);
+}
+
+static unsigned int
+take_u16(stream_t *s)
+{
+    unsigned int value = take_u8(s);
+    return value | ((unsigned int)take_u8(s) << 8);
+}
+
+static double
+take_f64(stream_t *s)
+{
+    uint8_t bytes[8];
+    double value;
+    int i;
+    for (i = 0; i < 8; i++) {
+        bytes[i] = take_u8(s);
+    }
+    memcpy(&value, bytes, 8);
+    return value;
+}
+
+static int
+compare_double(const void *a, const void *b)
+{
+    double da = *(const double *)a;
+    double db = *(const double *)b;
+    return (da > db) - (da < db);
+}
+
+/*
+Decode problem from fuzz input. Return -1 if the input is not usable,
+for example because values are not finite.
+
+x coordinates are sums of gaps, which can be zero, at a scale of 2**-40
+to 2**39. y values are small integers, producing equal slopes and ties
+of weights, or arbitrary doubles. Output coordinates are sorted,
+optionally extrapolated, or hit input x coordinates exactly.
+*/
+static int
+decode_problem(const uint8_t *data, size_t size, problem_t *p)
+{
+    stream_t s = {data, size, 1};
+    ptrdiff_t i;
+    unsigned int flags, mode;
+    double xscale, yscale, x0, x1, span;
+
+    p->n = 3 + (ptrdiff_t)(take_u16(&s) % (FUZZ_MAXN - 2));
+    p->m = (ptrdiff_t)(take_u16(&s) % (FUZZ_MAXM + 1));
+    p->split = p->m ? (ptrdiff_t)(take_u16(&s) % (p->m + 1)) : 0;
+    flags = take_u8(&s);
+    for (i = 0; i < 4; i++) {
+        static const int strides[4] = {1, 2, -1, 3};
+        p->strides[i] = strides[(flags >> (i * 2)) & 3];
+    }
+    mode = take_u8(&s);
+    p->single = mode & 1;
+    xscale = ldexp(1.0, (int)(take_u8(&s) % 80) - 40);
+    yscale = ldexp(1.0, (int)(take_u8(&s) % 80) - 40);
+
+    /* x coordinates */
+    x0 = (double)(int8_t)take_u8(&s) * xscale;
+    for (i = 0; i < p->n; i++) {
+        if (mode & 2) {
+            /* raw doubles, usually not monotonic */
+            x0 = take_f64(&s);
+        }
+        else if (i > 0) {
+            x0 += (double)take_u8(&s) * xscale;
+        }
+        p->x[i] = x0;
+    }
+
+    /* y values */
+    for (i = 0; i < p->n; i++) {
+        if (mode & 4) {
+            p->y[i] = take_f64(&s);
+        }
+        else {
+            p->y[i] = (double)(int8_t)take_u8(&s) * yscale;
+        }
+    }
+
+    /* output x coordinates */
+    x0 = p->x[0];
+    x1 = p->x[p->n - 1];
+    span = x1 - x0;
+    if (mode & 8) {
+        x0 -= span * 0.5;
+        x1 += span * 0.5;
+    }
+    for (i = 0; i < p->m; i++) {
+        unsigned int u = take_u16(&s);
+        if (u & 0x8000) {
+            p->xo[i] = p->x[u % p->n];
+        }
+        else {
+            p->xo[i] = x0 + (x1 - x0) * ((double)u / 0x7fff);
+        }
+    }
+
+    for (i = 0; i < p->n; i++) {
+        if (p->single) {
+            p->x[i] = (float)p->x[i];
+            p->y[i] = (float)p->y[i];
+        }
+        if (!isfinite(p->x[i]) || !isfinite(p->y[i])) {
+            return -1;
+        }
+    }
+    for (i = 0; i < p->m; i++) {
+        if (p->single) {
+            p->xo[i] = (float)p->xo[i];
+        }
+        if (!isfinite(p->xo[i])) {
+            return -1;
+        }
+    }
+    qsort(p->xo, (size_t)p->m, sizeof(double), compare_double);
+    return 0;
+}
+
+/*
+Interpolate problem with scalar reference implementation of Akima's
+method, following the operations of the kernels. Compute the tolerance
+of each output value from first-order bounds of rounding errors.
+*/
+static void
+reference_interpolate(const problem_t *p, reference_t *r)
+{
+    const double eps = DBL_EPSILON;
+    const double *x = p->x;
+    const double *y = p->y;
+    const ptrdiff_t n = p->n;
+    double ms[FUZZ_MAXN + 3], ems[FUZZ_MAXN + 3];
+    double b[FUZZ_MAXN], eb[FUZZ_MAXN];
+    double *m = ms + 2;          /* slopes of intervals -2 to n */
+    double *em = ems + 2;        /* errors of slopes */
+    double dx, dx2, xe0, xe1, ye0, ye1, eye0, eye1;
+    ptrdiff_t i, j;
+
+    r->error = 0;
+    for (i = 0; i < n - 1; i++) {
+        dx = x[i+1] - x[i];
+        if (dx < FUZZ_X_THRESHOLD) {
+            r->error = -1;
+            return;
+        }
+        m[i] = (y[i+1] - y[i]) / dx;
+        em[i] = 0.0;
+    }
+
+    /* extrapolated slopes on left side */
+    xe1 = x[0] + x[1] - x[2];
+    xe0 = xe1 + x[0] - x[1];
+    dx = x[0] - xe1;
+    dx2 = xe1 - xe0;
+    ye1 = dx * (m[1] - 2.0*m[0]) + y[0];
+    m[-1] = (y[0] - ye1) / dx;
+    ye0 = dx2 * (m[0] - 2.0*m[-1]) + ye1;
+    m[-2] = (ye1 - ye0) / dx2;
+    eye1 = eps * (fabs(dx) * (fabs(m[1]) + 2.0*fabs(m[0])) + fabs(ye1));
+    em[-1] = (eye1 + eps * fabs(y[0] - ye1)) / fabs(dx) + eps * fabs(m[-1]);
+    eye0 = eps * (fabs(dx2) * (fabs(m[0]) + 2.0*fabs(m[-1])) + fabs(ye0)) +
+           fabs(dx2) * 2.0 * em[-1] + eye1;
+    em[-2] = (eye1 + eye0 + eps * fabs(ye1 - ye0)) / fabs(dx2) +
+             eps * fabs(m[-2]);
+
+    /* extrapolated slopes on right side */
+    xe0 = x[n-1] + x[n-2] - x[n-3];
+    xe1 = xe0 + x[n-1] - x[n-2];
+    dx = xe0 - x[n-1];
+    dx2 = xe1 - xe0;
+    ye0 = (2.0*m[n-2] - m[n-3]) * dx + y[n-1];
+    m[n-1] = (ye0 - y[n-1]) / dx;
+    ye1 = (2.0*m[n-1] - m[n-2]) * dx2 + ye0;
+    m[n] = (ye1 - ye0) / dx2;
+    eye0 = eps * (fabs(dx) * (2.0*fabs(m[n-2]) + fabs(m[n-3])) + fabs(ye0));
+    em[n-1] = (eye0 + eps * fabs(ye0 - y[n-1])) / fabs(dx) +
+              eps * fabs(m[n-1]);
+    eye1 = eps * (fabs(dx2) * (2.0*fabs(m[n-1]) + fabs(m[n-2])) + fabs(ye1)) +
+           fabs(dx2) * 2.0 * em[n-1] + eye0;
+    em[n] = (eye0 + eye1 + eps * fabs(ye1 - ye0)) / fabs(dx2) +
+            eps * fabs(m[n]);
+
+    /* weighted slopes at input points */
+    for (i = 0; i < n; i++) {
+        double t0 = m[i-2], t1 = m[i-1], t2 = m[i], t3 = m[i+1];
+        double e0 = em[i-2], e1 = em[i-1], e2 = em[i], e3 = em[i+1];
+        double d0 = fabs(t3 - t2);
+        double d1 = fabs(t1 - t0);
+        double ed0 = e3 + e2 + eps * d0;
+        double ed1 = e1 + e0 + eps * d1;
+        double sd = d0 + d1;
+        double esd = ed0 + ed1 + eps * sd;
+        double w0 = 0.5 * (t1 + t2);
+        double ew0 = 0.5 * (e1 + e2) + eps * fabs(w0);
+        double w1 = (d0*t1 + d1*t2) / sd;
+        double ew1 = fabs(t1 - t2) / sd * (d1*ed0 + d0*ed1) / sd +
+                     (d0*e1 + d1*e2) / sd +
+                     2.0 * eps * (d0*fabs(t1) + d1*fabs(t2)) / sd +
+                     eps * fabs(w1);
+        if (sd < FUZZ_WEIGHTS_THRESHOLD) {
+            b[i] = w0;
+            eb[i] = ew0;
+        }
+        else {
+            b[i] = w1;
+            eb[i] = ew1;
+        }
+        if (fabs(sd - FUZZ_WEIGHTS_THRESHOLD) <= esd) {
+            /* kernels may select either slope */
+            eb[i] = (ew0 > ew1 ? ew0 : ew1) + fabs(w0 - w1);
+        }
+    }
+
+    /* evaluate polynomials at output points */
+    for (j = 0; j < p->m; j++) {
+        double t, h, s, c0, c1, c2, c3, err;
+        double t2, t3, eb0, eb1;
+        i = 0;
+        while ((i < n - 2) && (p->xo[j] > x[i+1])) {
+            i++;
+        }
+        h = x[i+1] - x[i];
+        s = (y[i+1] - y[i]) / h;
+        c0 = y[i];
+        c1 = b[i];
+        c2 = (3.0*s - 2.0*b[i] - b[i+1]) / h;
+        c3 = (b[i] + b[i+1] - 2.0*s) / (h*h);
+        t = p->xo[j] - x[i];
+        t2 = t * t;
+        t3 = fabs(t2 * t);
+        eb0 = eb[i];
+        eb1 = eb[i+1];
+        r->yo[j] = c0 + t*(c1 + t*(c2 + t*c3));
+        err = eps * (fabs(c0) + fabs(t*c1) + t2*fabs(c2) + t3*fabs(c3));
+        err += eps * (t2 * (3.0*fabs(s) + 2.0*fabs(b[i]) + fabs(b[i+1])) / h +
+                      t3 * (fabs(b[i]) + fabs(b[i+1]) + 2.0*fabs(s)) / (h*h));
+        err += fabs(t) * eb0 + t2 * (2.0*eb0 + eb1) / h +
+               t3 * (eb0 + eb1) / (h*h);
+        err += DBL_MIN * eps;  /* rounding of subnormal values */
+        r->tol[j] = FUZZ_ULPS * err;
+        if (!isfinite(r->yo[j]) || !isfinite(r->tol[j]) ||
+                (p->single && (fabs(r->yo[j]) > FLT_MAX))) {
+            r->tol[j] = NAN;
+        }
+    }
+}
+
+static size_t checked = 0;       /* number of output values compared */
+static size_t rejected = 0;      /* number of problems with invalid x */
+
+static void
+fail(const problem_t *p, const char *variant, const char *path,
+     const char *message, ptrdiff_t j, double value, const reference_t *r)
+{
+    ptrdiff_t i;
+
+    fprintf(stderr, "akima_fuzz: %s %s %s: %s\n",
+            p->single ? "float32" : "float64", variant, path, message);
+    fprintf(stderr, "n=%td m=%td split=%td strides=%d,%d,%d,%d\n",
+            p->n, p->m, p->split, p->strides[0], p->strides[1],
+            p->strides[2], p->strides[3]);
+    if (j >= 0) {
+        fprintf(stderr,
+                "x_new[%td]=%.17g value=%.17g reference=%.17g "
+                "difference=%.3g tolerance=%.3g\n",
+                j, p->xo[j], value, r->yo[j], fabs(value - r->yo[j]),
+                r->tol[j]);
+    }
+    for (i = 0; i < p->n; i++) {
+        fprintf(stderr, "x[%td]=%.17g y[%td]=%.17g\n",
+                i, p->x[i], i, p->y[i]);
+    }
+    fflush(stderr);
+    abort();
+}
+
+/*
+Store values at stride in items into buffer or fill buffer with NaN if
+values is NULL. Return address of first item.
+*/
+static char *
+store(const double *values, ptrdiff_t size, int stride, int single,
+      char *buffer)
+{
+    const ptrdiff_t itemsize = single ? 4 : 8;
+    char *first = buffer;
+    ptrdiff_t i;
+
+    if (values == NULL) {
+        memset(buffer, 0xff, (size_t)(size * (stride < 0 ? -stride : stride) *
+                                      itemsize));
+    }
+    if (stride < 0) {
+        first = buffer + (size - 1) * -stride * itemsize;
+    }
+    for (i = 0; (values != NULL) && (i < size); i++) {
+        char *item = first + i * stride * itemsize;
+        if (single) {
+            float value = (float)values[i];
+            memcpy(item, &value, 4);
+        }
+        else {
+            memcpy(item, &values[i], 8);
+        }
+    }
+    return first;
+}
+
+/* Load value at index from array of stride in items */
+static double
+load(const char *first, ptrdiff_t index, int stride, int single)
+{
+    if (single) {
+        float value;
+        memcpy(&value, first + index * stride * 4, 4);
+        return value;
+    }
+    else {
+        double value;
+        memcpy(&value, first + index * stride * 8, 8);
+        return value;
+    }
+}
+
+/* Compare output values of variant to reference */
+static void
+check(const problem_t *p, const reference_t *r, const char *variant,
+      const char *path, const char *yo, int stride)
+{
+    ptrdiff_t j;
+
+    for (j = 0; j < p->m; j++) {
+        double value = load(yo, j, stride, p->single);
+        double tol = r->tol[j];
+        if (isnan(tol)) {
+            continue;
+        }
+        if (p->single) {
+            tol += FLT_EPSILON * (fabs(r->yo[j]) + tol + FLT_MIN);
+        }
+        if (!(fabs(value - r->yo[j]) <= tol)) {
+            fail(p, variant, path, "value out of tolerance", j, value, r);
+        }
+        checked++;
+    }
+}
+
+/* Buffers of strided arrays */
+static char xbuf[FUZZ_MAXN * 3 * 8];
+static char ybuf[FUZZ_MAXN * 3 * 8];
+static char xobuf[FUZZ_MAXM * 3 * 8];
+static char yobuf[FUZZ_MAXM * 3 * 8];
+static double coefficients[AKIMA_BUFFER_SIZE(FUZZ_MAXN)];
+
+/*
+Run variant on problem with strides and compare to reference.
+Evaluate output points in two chunks, split at p->split.
+*/
+static void
+run_variant(const problem_t *p, const reference_t *r, const variant_t *v,
+            const int *strides, const char *path)
+{
+    const ptrdiff_t itemsize = p->single ? 4 : 8;
+    coefficients_t coefficients_func;
+    evaluate_t evaluate_func;
+    const char *xi, *yi, *xo;
+    char *yo;
+    ptrdiff_t dxi, dyi, dxo, dyo;
+    int error;
+
+    coefficients_func = p->single ? v->coefficients_f : v->coefficients;
+    evaluate_func = p->single ? v->evaluate_f : v->evaluate;
+    xi = store(p->x, p->n, strides[0], p->single, xbuf);
+    yi = store(p->y, p->n, strides[1], p->single, ybuf);
+    xo = store(p->xo, p->m, strides[2], p->single, xobuf);
+    yo = store(NULL, p->m, strides[3], p->single, yobuf);
+    dxi = strides[0] * itemsize;
+    dyi = strides[1] * itemsize;
+    dxo = strides[2] * itemsize;
+    dyo = strides[3] * itemsize;
+
+    memset(coefficients, 0xff, sizeof(coefficients));
+    error = coefficients_func(p->n, xi, dxi, yi, dyi, coefficients);
+    if (error != r->error) {
+        fail(p, v->name, path, "error differs from reference", -1, 0.0, r);
+    }
+    if (error != 0) {
+        return;
+    }
+    evaluate_func(
+        p->n, xi, dxi, coefficients, p->split, xo, dxo, yo, dyo);
+    evaluate_func(
+        p->n, xi, dxi, coefficients, p->m - p->split,
+        xo + p->split * dxo, dxo, yo + p->split * dyo, dyo);
+    check(p, r, v->name, path, yo, strides[3]);
+}
+
+/* Run akima_interpolate and spline API on problem with strides */
+static void
+run_interpolate(const problem_t *p, const reference_t *r,
+                const int *strides)
+{
+    const ptrdiff_t itemsize = p->single ? 4 : 8;
+    const char *xi, *yi, *xo;
+    char *yo;
+    ptrdiff_t dxi, dyi, dxo, dyo;
+    akima_spline *spline;
+    int error;
+
+    xi = store(p->x, p->n, strides[0], p->single, xbuf);
+    yi = store(p->y, p->n, strides[1], p->single, ybuf);
+    xo = store(p->xo, p->m, strides[2], p->single, xobuf);
+    yo = store(NULL, p->m, strides[3], p->single, yobuf);
+    dxi = strides[0] * itemsize;
+    dyi = strides[1] * itemsize;
+    dxo = strides[2] * itemsize;
+    dyo = strides[3] * itemsize;
+
+    if (p->single) {
+        error = akima_interpolate_f(
+            p->n, xi, dxi, yi, dyi, p->m, xo, dxo, yo, dyo, coefficients);
+    }
+    else {
+        error = akima_interpolate(
+            p->n, xi, dxi, yi, dyi, p->m, xo, dxo, yo, dyo, coefficients);
+    }
+    if (error != r->error) {
+        fail(p, "dispatch", "akima_interpolate",
+             "error differs from reference", -1, 0.0, r);
+    }
+    if (error == 0) {
+        check(p, r, "dispatch", "akima_interpolate", yo, strides[3]);
+    }
+    if (p->single) {
+        return;
+    }
+
+    spline = akima_spline_create(p->n, xi, dxi, yi, dyi);
+    if ((spline == NULL) != (r->error != 0)) {
+        fail(p, "dispatch", "akima_spline_create",
+             "error differs from reference", -1, 0.0, r);
+    }
+    if (spline == NULL) {
+        return;
+    }
+    yo = store(NULL, p->m, strides[3], 0, yobuf);
+    akima_spline_evaluate(spline, p->m, xo, dxo, yo, dyo);
+    akima_spline_destroy(spline);
+    check(p, r, "dispatch", "akima_spline_evaluate", yo, strides[3]);
+}
+
+int
+LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    static problem_t p;
+    static reference_t r;
+    static const int contiguous[4] = {1, 1, 1, 1};
+    static int initialized = 0;
+    int i;
+
+    if (!initialized) {
+        init_variants();
+        initialized = 1;
+    }
+    if (decode_problem(data, size, &p) != 0) {
+        return 0;
+    }
+    reference_interpolate(&p, &r);
+    if (r.error != 0) {
+        rejected++;
+    }
+    for (i = 0; i < FUZZ_NVARIANTS; i++) {
+        if (!variants[i].supported) {
+            continue;
+        }
+        run_variant(&p, &r, &variants[i], contiguous, "contiguous");
+        run_variant(&p, &r, &variants[i], p.strides, "strided");
+    }
+    run_interpolate(&p, &r, contiguous);
+    run_interpolate(&p, &r, p.strides);
+    return 0;
+}
+
+#if !defined(AKIMA_FUZZ_LIBFUZZER)
+
+/* xorshift64* pseudo-random number generator */
+static uint64_t
+random_next(uint64_t *state)
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1DULL;
+}
+
+static int
+replay(const char *filename)
+{
+    FILE *file;
+    uint8_t *data;
+    long size;
+
+    file = fopen(filename, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "akima_fuzz: can not open %s\n", filename);
+        return -1;
+    }
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    data = (uint8_t *)malloc(size > 0 ? (size_t)size : 1);
+    if ((data == NULL) ||
+            (fread(data, 1, (size_t)size, file) != (size_t)size)) {
+        fprintf(stderr, "akima_fuzz: can not read %s\n", filename);
+        fclose(file);
+        free(data);
+        return -1;
+    }
+    fclose(file);
+    LLVMFuzzerTestOneInput(data, (size_t)size);
+    free(data);
+    return 0;
+}
+
+static void
+usage(void)
+{
+    fprintf(stderr, "usage: akima_fuzz [-r runs] [-s seed] [file ...]\n");
+    exit(2);
+}
+
+int
+main(int argc, char **argv)
+{
+    static uint8_t data[8192];
+    long runs = 100000;
+    uint64_t seed = 1;
+    uint64_t state;
+    long run;
+    size_t size, k;
+    int i, files = 0;
+
+    for (i = 1; i < argc; i++) {
+        if ((strcmp(argv[i], "-r") == 0) && (i + 1 < argc)) {
+            runs = atol(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-s") == 0) && (i + 1 < argc)) {
+            seed = strtoull(argv[++i], NULL, 10);
+        }
+        else if (argv[i][0] == '-') {
+            usage();
+        }
+        else {
+            if (replay(argv[i]) != 0) {
+                return 1;
+            }
+            files++;
+        }
+    }
+    if (files == 0) {
+        state = seed * 0x9E3779B97F4A7C15ULL + 1;
+        for (run = 0; run < runs; run++) {
+            /* mostly small problems, where extrapolation dominates */
+            size = (size_t)(random_next(&state) % 64);
+            if (run % 4 == 0) {
+                size = (size_t)(random_next(&state) % sizeof(data));
+            }
+            for (k = 0; k < size; k++) {
+                data[k] = (uint8_t)(random_next(&state) >> 56);
+            }
+            LLVMFuzzerTestOneInput(data, size);
+        }
+    }
+    printf("akima_fuzz: %s %s, %ld inputs, %d files, %zu values, "
+           "%zu rejected\n",
+           akima_cpu_target(), akima_fp_mode(), files ? 0L : runs, files,
+           checked, rejected);
+    return 0;
+}
+
+#endif
@@ -0,0 +1,432 @@
+# akima/fuzz/test_fuzz_interpolate.py
+
+"""Differential fuzzing of the akima package.
+
+Property-based tests generating adversarial `x`, `y`, and `x_new`, array
+layouts, axes, and dtypes with `Hypothesis <https://hypothesis.works>`_.
+Contiguous 1D float64 results of the C extension are compared to the
+pure Python implementation, ``akima.interpolate_py``.
+The results of all other interpolation functions and code paths of the
+C extension are compared to interpolating contiguous 1D float64 lanes
+one at a time with ``akima.interpolate``:
+
+- N-D `y` along any axis, strided, and in threads (maxworkers).
+- N-D `x` and `x_new` broadcast against `y`.
+- Output arrays, workspaces, and byte-swapped or converted inputs.
+- ``interpolate_batch``, ``interpolate_gufunc`` (float32 and float64),
+  and ``interpolate_chunked``.
+
+All variants run the same kernel, such that results must agree within
+a few units in the last place of the magnitude of `y`. Inputs with `x`
+that are not monotonically increasing must be rejected by all variants.
+The kernels themselves are compared against a scalar reference
+implementation by the akima_fuzz fuzzer in akima_fuzz.c.
+
+The properties run offline with a fixed seed and without example
+database. They are skipped if Hypothesis is not installed. Set the
+AKIMA_FUZZ_EXAMPLES environment variable to change the number of
+examples per property (default 100)::
+
+    python -m pytest fuzz
+    AKIMA_FUZZ_EXAMPLES=10000 python fuzz/test_fuzz_interpolate.py
+
+"""
+
+from __future__ import annotations
+
+import asyncio
+import os
+import sys
+
+import numpy
+import pytest
+
+try:
+    import akima
+except ImportError:
+    sys.path.insert(0, os.path.dirname(os.path.dirname(__file__)))
+    import akima
+
+pytest.importorskip('hypothesis')
+
+from hypothesis import assume, given, settings  # noqa: E402
+from hypothesis import strategies as st  # noqa: E402
+
+if not hasattr(akima, 'interpolate_py'):
+    pytest.skip('C extension not available', allow_module_level=True)
+
+ULPS = 16
+"""Tolerance in units of the last place of the magnitude of y."""
+
+SETTINGS = settings(
+    max_examples=int(os.environ.get('AKIMA_FUZZ_EXAMPLES', '100')),
+    derandomize=True,
+    database=None,
+    deadline=None,
+)
+"""Deterministic settings of all properties."""
+
+
+@st.composite
+def problems(draw, lanes=True):
+    """Return x, y, and sorted x_new, with y of shape (lanes, n)."""
+    n = draw(st.integers(3, 40))
+    m = draw(st.integers(0, 100))
+    xscale = 2.0 ** draw(st.integers(-30, 30))
+    yscale = 2.0 ** draw(st.integers(-60, 60))
+    # integer gaps and values produce duplicate x, equal slopes, and ties
+    gaps = draw(
+        st.lists(st.integers(0, 255), min_size=n - 1, max_size=n - 1)
+        | st.lists(
+            st.floats(0.0, 1e3, allow_subnormal=False),
+            min_size=n - 1,
+            max_size=n - 1,
+        )
+    )
+    x = numpy.cumsum([0.0] + gaps) * xscale + draw(st.integers(-99, 99))
+    shape = (draw(st.integers(1, 4)) if lanes else 1, n)
+    y = numpy.array(
+        draw(
+            st.lists(
+                st.integers(-8, 8) | st.floats(-1.0, 1.0, width=64),
+                min_size=shape[0] * n,
+                max_size=shape[0] * n,
+            )
+        ),
+        dtype=numpy.float64,
+    ).reshape(shape)
+    y *= yscale
+    span = x[-1] - x[0]
+    extrapolate = draw(st.booleans())
+    x_new = numpy.array(
+        draw(
+            st.lists(
+                st.floats(0.0, 1.0) | st.sampled_from(list(range(n))),
+                min_size=m,
+                max_size=m,
+            )
+        ),
+        dtype=numpy.float64,
+    )
+    knots = x_new >= 1.0
+    x_new[knots] = x[x_new[knots].astype(numpy.intp)]
+    lo = x[0] - (0.5 * span if extrapolate else 0.0)
+    hi = x[-1] + (0.5 * span if extrapolate else 0.0)
+    x_new[~knots] = lo + (hi - lo) * x_new[~knots]
+    x_new.sort()
+    return x, y, x_new
+
+
+def reference(x, y, x_new):
+    """Return lanes of y interpolated one at a time or None if x invalid."""
+    try:
+        return numpy.stack(
+            [
+                akima.interpolate(x, numpy.array(lane), x_new)
+                for lane in numpy.reshape(y, (-1, y.shape[-1]))
+            ]
+        ).reshape(y.shape[:-1] + (x_new.size,))
+    except ValueError:
+        return None
+
+
+def check(result, expected, y, dtype=numpy.float64):
+    """Assert result agrees with expected within ULPS of magnitude of y."""
+    scale = max(
+        float(numpy.max(numpy.abs(y), initial=0.0)),
+        float(numpy.max(numpy.abs(expected), initial=0.0)),
+    )
+    eps = float(numpy.finfo(dtype).eps)
+    numpy.testing.assert_allclose(
+        result, expected, rtol=ULPS * eps, atol=ULPS * eps * scale
+    )
+
+
+def python_slopes(x, y):
+    """Return slopes of intervals -2 to n as in interpolate_py."""
+    n = x.size
+    m = numpy.diff(y) / numpy.diff(x)
+    mm = 2.0 * m[0] - m[1]
+    mmm = 2.0 * mm - m[0]
+    mp = 2.0 * m[n - 2] - m[n - 3]
+    mpp = 2.0 * mp - m[n - 2]
+    return numpy.concatenate(([mmm], [mm], m, [mp], [mpp]))
+
+
+@SETTINGS
+@given(problems(lanes=False))
+def test_python(problem):
+    """Compare C extension to pure Python implementation."""
+    x, y, x_new = problem
+    y = y[0]
+    x_new = x_new[(x_new >= x[0]) & (x_new <= x[-1])]
+    dx = numpy.diff(x)
+    if numpy.any(dx <= 0.0):
+        with pytest.raises(ValueError):
+            akima.interpolate(x, y, x_new)
+        with pytest.raises(ValueError):
+            akima.interpolate_py(x, y, x_new)
+        return
+    # the C extension also rejects differences smaller than 1e-12
+    assume(numpy.min(dx) > 1e-9)
+
+    # scale slopes to magnitude 1 and stay away from the weight
+    # thresholds, which are absolute in C and relative in Python
+    scale = float(numpy.max(numpy.abs(python_slopes(x, y))))
+    assume(0.0 < scale < numpy.inf)
+    y = y / scale
+    m = python_slopes(x, y)
+    dm = numpy.abs(numpy.diff(m))
+    sd = dm[2:] + dm[:-2]
+    assume(numpy.min(sd) > 1e-3)
+
+    result = akima.interpolate(x, y, x_new)
+    expected = akima.interpolate_py(x, y, x_new)
+    # rounding errors of slopes are amplified by the weights
+    cond = float(numpy.max(numpy.abs(m[1:-2] - m[2:-1]) / sd))
+    eps = float(numpy.finfo(numpy.float64).eps)
+    atol = ULPS * eps * (
+        float(numpy.max(numpy.abs(y))) + float(numpy.max(dx)) * (1.0 + cond)
+    )
+    numpy.testing.assert_allclose(result, expected, rtol=0, atol=atol)
+
+
+@SETTINGS
+@given(problems(), st.sampled_from([-1, 0, 1, 2]), st.sampled_from([1, 2, 0]))
+def test_axis(problem, axis, maxworkers):
+    """Interpolate N-D y along axis in threads."""
+    x, y, x_new = problem
+    expected = reference(x, y, x_new)
+    # y of shape (2, lanes, n) with interpolation axis moved to axis
+    y = numpy.moveaxis(numpy.stack([y, -y]), -1, axis)
+    if expected is None:
+        with pytest.raises(ValueError):
+            akima.interpolate(x, y, x_new, axis=axis)
+        return
+    expected = numpy.moveaxis(numpy.stack([expected, -expected]), -1, axis)
+    result = akima.interpolate(x, y, x_new, axis=axis, maxworkers=maxworkers)
+    check(result, expected, y)
+
+
+@SETTINGS
+@given(problems(), st.booleans())
+def test_out(problem, reverse):
+    """Interpolate into strided output array using workspace."""
+    x, y, x_new = problem
+    expected = reference(x, y, x_new)
+    if expected is None:
+        return
+    out = numpy.full((y.shape[0], x_new.size, 2), numpy.nan)[..., 0]
+    if reverse:
+        out = out[::-1]
+        expected = expected[::-1]
+        y = y[::-1]
+    workspace = akima.Workspace()
+    akima.interpolate(x, y, x_new, out=out, workspace=workspace)
+    check(out, expected, y)
+
+
+@SETTINGS
+@given(problems(), st.sampled_from([1, 2, 0]))
+def test_async(problem, maxworkers):
+    """Interpolate in executor with keyword arguments of interpolate."""
+    x, y, x_new = problem
+    expected = reference(x, y, x_new)
+    if expected is None:
+        return
+    out = numpy.empty_like(expected)
+    result = asyncio.run(
+        akima.interpolate_async(
+            x,
+            y,
+            x_new,
+            out=out,
+            maxworkers=maxworkers,
+            workspace=akima.Workspace(),
+        )
+    )
+    assert result is None
+    check(out, expected, y)
+
+
+@SETTINGS
+@given(problems(), st.sampled_from(['>f8', '<f4', 'i8', 'unaligned']))
+def test_convert(problem, kind):
+    """Interpolate inputs that are converted to native float64."""
+    x, y, x_new = problem
+    if kind == 'unaligned':
+        buffer = numpy.zeros(y.nbytes + 1, numpy.uint8)
+        y = numpy.frombuffer(buffer[1:].data, y.dtype).reshape(y.shape)
+        y[:] = problem[1]
+    elif kind == 'i8':
+        y = numpy.round(numpy.clip(y, -(2**52), 2**52)).astype(kind)
+    else:
+        y = y.astype(kind)
+    expected = reference(x, y.astype(numpy.float64), x_new)
+    if expected is None:
+        return
+    check(akima.interpolate(x, y, x_new), expected, expected)
+
+
+@SETTINGS
+@given(problems())
+def test_broadcast(problem):
+    """Interpolate with N-D x and x_new broadcast against y."""
+    x, y, x_new = problem
+    expected = reference(x, y, x_new)
+    if expected is None:
+        return
+    xs = numpy.broadcast_to(x, y.shape)
+    xs_new = numpy.broadcast_to(x_new, (1, x_new.size))
+    check(akima.interpolate(xs, y, xs_new), expected, y)
+
+
+@SETTINGS
+@given(
+    st.lists(problems(lanes=False), min_size=1, max_size=8),
+    st.sampled_from([1, 2, 0]),
+)
+def test_batch(batch, maxworkers):
+    """Interpolate batch of independent problems."""
+    expected = [reference(x, y, x_new) for x, y, x_new in batch]
+    if any(e is None for e in expected):
+        return
+    offsets = numpy.cumsum([0] + [x.size for x, _, _ in batch])
+    offsets_new = numpy.cumsum([0] + [x_new.size for _, _, x_new in batch])
+    result = akima.interpolate_batch(
+        numpy.concatenate([x for x, _, _ in batch]),
+        numpy.concatenate([y[0] for _, y, _ in batch]),
+        numpy.concatenate([x_new for _, _, x_new in batch]),
+        offsets,
+        offsets_new,
+        maxworkers=maxworkers,
+    )
+    for i, e in enumerate(expected):
+        check(result[offsets_new[i] : offsets_new[i + 1]], e[0], batch[i][1])
+
+
+@SETTINGS
+@given(problems(), st.sampled_from(['float64', 'float32']), st.booleans())
+def test_gufunc(problem, dtype, strided):
+    """Interpolate with generalized ufunc in float32 or float64."""
+    x, y, x_new = (a.astype(dtype) for a in problem)
+    expected = reference(
+        x.astype(numpy.float64), y.astype(numpy.float64), x_new
+    )
+    if expected is None:
+        return
+    if strided:
+        y = numpy.ascontiguousarray(y.T).T
+    result = akima.interpolate_gufunc(x, y, x_new)
+    assert result.dtype == dtype
+    check(result, expected.astype(dtype), y, dtype)
+
+
+@SETTINGS
+@given(problems(), st.integers(8, 512), st.sampled_from(['2d', '1d', 'T']))
+def test_chunked(problem, chunksize, layout):
+    """Interpolate in chunks of lanes or in windows along axis."""
+    x, y, x_new = problem
+    expected = reference(x, y, x_new)
+    if expected is None:
+        return
+    if layout == '1d':
+        y = y[0]
+        expected = expected[0]
+    if layout == 'T':
+        # windows along axis 0 of C-contiguous y
+        y = numpy.ascontiguousarray(y.T)
+        result = akima.interpolate_chunked(
+            x, y, x_new, axis=0, chunksize=chunksize
+        ).T
+    else:
+        result = akima.interpolate_chunked(x, y, x_new, chunksize=chunksize)
+    check(result, expected, y)
+
+
+def chunked_problem(shape, axis):
+    """Return x, y, and x_new for deterministic interpolate_chunked tests."""
+    x = numpy.cumsum(numpy.linspace(0.5, 1.5, shape[axis]))
+    y = numpy.sin(numpy.arange(numpy.prod(shape)) * 0.01).reshape(shape)
+    x_new = numpy.linspace(x[0] - 2.0, x[-1] + 2.0, 3 * shape[axis] + 1)
+    x_new = numpy.sort(numpy.concatenate((x_new, x[::7])))
+    return x, y, x_new
+
+
+@pytest.mark.parametrize('chunksize', [1, 100, 4096, 2**26])
+def test_chunked_1d(chunksize):
+    """Interpolate 1D y in overlapping windows."""
+    x, y, x_new = chunked_problem((1000,), 0)
+    result = akima.interpolate_chunked(x, y, x_new, chunksize=chunksize)
+    numpy.testing.assert_array_equal(result, akima.interpolate(x, y, x_new))
+
+
+@pytest.mark.parametrize('chunksize', [1, 100, 4096, 2**26])
+def test_chunked_axis0(chunksize):
+    """Interpolate along axis 0 of C-contiguous y in windows."""
+    x, y, x_new = chunked_problem((1000, 7), 0)
+    out = numpy.empty((x_new.size, 7))
+    akima.interpolate_chunked(
+        x, y, x_new, axis=0, out=out, chunksize=chunksize
+    )
+    numpy.testing.assert_array_equal(
+        out, akima.interpolate(x, y, x_new, axis=0)
+    )
+
+
+@pytest.mark.parametrize('axis', [0, 1])
+def test_chunked_memmap(tmp_path, monkeypatch, axis):
+    """Interpolate memmap y into memmap out, prefetching contiguous pages."""
+    x, y, x_new = chunked_problem((2000, 10) if axis == 0 else (10, 2000), axis)
+    ymap = numpy.memmap(
+        tmp_path / 'y.bin', dtype=numpy.float32, mode='w+', shape=y.shape
+    )
+    ymap[:] = y
+    ymap.flush()
+    ymap = numpy.memmap(
+        tmp_path / 'y.bin', dtype=numpy.float32, mode='r', shape=y.shape
+    )
+    shape = list(y.shape)
+    shape[axis] = x_new.size
+    out = numpy.memmap(
+        tmp_path / 'out.bin', dtype=numpy.float64, mode='w+', shape=shape
+    )
+    advised = []
+    madvise = akima.akima._madvise_willneed
+
+    def willneed(a):
+        assert isinstance(a, numpy.memmap)
+        advised.append(a.nbytes)
+        madvise(a)
+
+    monkeypatch.setattr(akima.akima, '_madvise_willneed', willneed)
+    chunksize = 8000
+    assert (
+        akima.interpolate_chunked(
+            x, ymap, x_new, axis=axis, out=out, chunksize=chunksize
+        )
+        is None
+    )
+    expected = akima.interpolate(
+        x, y.astype(numpy.float32).astype(numpy.float64), x_new, axis=axis
+    )
+    numpy.testing.assert_array_equal(out, expected)
+    # blocks are contiguous and about chunksize bytes of y
+    assert len(advised) > 1
+    assert max(advised) <= chunksize + 7 * 10 * ymap.itemsize
+
+
+def main(argv=None):
+    """Run all properties with pytest."""
+    if argv is None:
+        argv = sys.argv
+    akima.show_config()
+    # hypothesis is imported before pytest can rewrite its assertions
+    return pytest.main(
+        [__file__, '-v', '-W', 'ignore::pytest.PytestAssertRewriteWarning']
+        + list(argv[1:])
+    )
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -2,11 +2,15 @@
 
 """Akima package Setuptools script."""
 
+import os
 import re
+import shutil
+import subprocess
 import sys
 
 import numpy
 from setuptools import Extension, setup
+from setuptools.command.build_ext import build_ext
 
 
 def search(pattern, string, flags=0):
@@ -35,6 +39,105 @@ def fix_docstring_examples(docstring):
     return '\n'.join(lines)
 
 
+# representative workload run by the instrumented extension in PGO builds
+PGO_WORKLOAD = """
+import importlib.util
+import sys
+
+import numpy
+
+spec = importlib.util.spec_from_file_location('_akima', sys.argv[1])
+_akima = importlib.util.module_from_spec(spec)
+spec.loader.exec_module(_akima)
+
+rng = numpy.random.default_rng(42)
+for n, m in ((16, 1000), (1000, 100), (1000, 100000), (100000, 100000)):
+    x = numpy.cumsum(rng.uniform(0.1, 1.0, n))
+    x_new = numpy.sort(rng.uniform(x[0], x[-1], m))
+    for y in (rng.normal(size=n), numpy.sin(x), numpy.repeat(x[::4], 4)[:n]):
+        for _ in range(max(10**6 // (n + m), 1)):
+            _akima.interpolate(x, y, x_new)
+        y2 = numpy.stack([y] * 8, axis=1)
+        _akima.interpolate(x, y2, x_new, axis=0)
+        _akima.interpolate_gufunc(
+            x.astype(numpy.float32),
+            y.astype(numpy.float32),
+            x_new.astype(numpy.float32),
+        )
+sizes = rng.integers(3, 64, 10000)
+offsets = numpy.concatenate(([0], numpy.cumsum(sizes)))
+x = numpy.concatenate([numpy.arange(s, dtype=numpy.float64) for s in sizes])
+y = rng.normal(size=x.size)
+_akima.interpolate_batch(x, y, x + 0.5, offsets, offsets)
+"""
+
+
+class BuildExt(build_ext):
+    """Build extensions, optionally profile-guided and link-time optimized.
+
+    If the AKIMA_PGO environment variable is set to 1 and the compiler is
+    GCC, the extension is built instrumented, PGO_WORKLOAD is run, and the
+    extension is rebuilt using the profile and -flto.
+    Other compilers build with -flto only.
+
+    """
+
+    def build_extension(self, ext):
+        if os.environ.get('AKIMA_PGO', '0') in {'', '0'}:
+            return super().build_extension(ext)
+        if self.compiler.compiler_type != 'unix':
+            print('AKIMA_PGO is not supported by this compiler')
+            return super().build_extension(ext)
+
+        compile_args = list(ext.extra_compile_args or [])
+        link_args = list(ext.extra_link_args or [])
+        self.force = True
+
+        if not self._is_gcc():
+            print('AKIMA_PGO requires GCC, building with -flto only')
+            ext.extra_compile_args = compile_args + ['-flto']
+            ext.extra_link_args = link_args + ['-flto']
+            return super().build_extension(ext)
+
+        profile = os.path.abspath(os.path.join(self.build_temp, 'pgo'))
+        shutil.rmtree(profile, ignore_errors=True)
+
+        # value profiling crashes in the ifunc resolvers of target_clones
+        generate = [f'-fprofile-generate={profile}', '-fno-profile-values']
+        ext.extra_compile_args = compile_args + generate
+        ext.extra_link_args = link_args + generate
+        super().build_extension(ext)
+        fullpath = self.get_ext_fullpath(ext.name)
+        subprocess.run(
+            [sys.executable, '-c', PGO_WORKLOAD, fullpath], check=True
+        )
+
+        use = [
+            f'-fprofile-use={profile}',
+            '-fprofile-correction',
+            '-Wno-missing-profile',
+            '-flto=auto',
+        ]
+        ext.extra_compile_args = compile_args + use
+        ext.extra_link_args = link_args + use
+        return super().build_extension(ext)
+
+    def _is_gcc(self):
+        """Return True if C compiler is GCC."""
+        try:
+            output = subprocess.run(
+                [self.compiler.compiler_so[0], '--version'],
+                capture_output=True,
+                text=True,
+                check=True,
+            ).stdout
+        except (OSError, subprocess.CalledProcessError):
+            return False
+        return 'clang' not in output.lower() and (
+            'gcc' in output.lower() or 'free software' in output.lower()
+        )
+
+
 with open('akima/akima.py', encoding='utf-8') as fh:
     code = fh.read()
 
@@ -87,14 +190,21 @@ setup(
     python_requires='>=3.10',
     install_requires=['numpy'],
     packages=['akima'],
-    package_data={'akima': ['py.typed']},
+    package_data={'akima': ['py.typed', 'akima.h', 'akima_capi.h']},
     ext_modules=[
         Extension(
             'akima._akima',
-            ['akima/akima.c'],
+            ['akima/akima.c', 'akima/libakima.c'],
+            depends=[
+                'akima/akima.h',
+                'akima/akima_capi.h',
+                'akima/akima_probes.h',
+                'akima/akima_template.h',
+            ],
             include_dirs=[numpy.get_include()],
         )
     ],
+    cmdclass={'build_ext': BuildExt},
     zip_safe=False,
     platforms=['any'],
     classifiers=[
@@ -109,5 +219,6 @@ setup(
         'Programming Language :: Python :: 3.11',
         'Programming Language :: Python :: 3.12',
         'Programming Language :: Python :: 3.13',
+        'Programming Language :: Python :: Free Threading :: 2 - Beta',
     ],
 )